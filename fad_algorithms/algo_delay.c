@@ -7,65 +7,102 @@
  * Description:
  * This algorithms purposely creates a shifted array that allows for input sound data
  * to be offset by a predetermined amount and create delayed feedback for the user.
+ * The delay can be changed while running; the read position ramps to the new delay.
  */
 
 #include "algo_delay.h"
 #include <stdlib.h>
-#include <string.h>
 #include "fad_defs.h"
 
-/* Defines how many values the algorithm will read from the ADC buffer. Should always be at least half of buffer size. */
-int algo_delay_read_size_g = 512;
-
-/* Define any globals */
-/* This delay size determines how many samples (in terms of output) to shift the incoming signal by. Determines delay time. */
-int delay_size_g = 5000; //was 10000
+/*
+ * Ramping delay: move the read position a step per sample and interpolate between the stored
+ * values around it, so the output glides to the new delay instead of jumping.
+ */
+static void delay_ramp(algo_delay_ctx_t *s, const fad_q15_t *in, fad_q15_t *out, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        if (--s->ramp_remaining == 0) s->delay = s->delay_target;
+        else s->delay += s->delay_step;
 
-/* This is a circular buffer that holds signals for the output delay. Needs to be allocated based on the sample delay amount. */
-uint8_t *delay_buffer_g;
+        out[i] = fad_delay_line_tap_frac(&s->line, s->delay, s->interp);
 
-/* This is the current position in the delay buffer. */
-int delay_buffer_pos_g;
+        fad_delay_line_write(&s->line, &in[i], 1);
+    }
+}
 
-void algo_delay(uint16_t *in_buff, uint8_t *out_buff, uint16_t in_pos, uint16_t out_pos, int multisamples) {
+void algo_delay(void *ctx, const fad_span_t *in, const fad_span_t *out) {
+    algo_delay_ctx_t *s = ctx;
+    fad_span_run_t runs[FAD_SPAN_MAX_RUNS];
+    int num_runs = fad_span_runs(in, out, runs);
 
-    for(int i = 0; i < (algo_delay_read_size_g) / multisamples; i++)
+    for (int r = 0; r < num_runs; r++)
     {
-        //Place the appropriate delayed value into the out_buff
-        out_buff[out_pos + i] = delay_buffer_g[delay_buffer_pos_g];
-        
-        /* Get average of last multisample values from adc */
-        // int multisample_average = 0;
-        // for (int j = 0; j < multisamples; j++) {
-        //     multisample_average += in_buff[in_pos + (multisamples * i) + j];
-        // }
-
-        // /* Actual average division */
-        // multisample_average /= multisamples;
-
-        //Place the current input data into the offset location in delay_buffer_g
-        delay_buffer_g[delay_buffer_pos_g] = in_buff[in_pos + i] >> 4; //multisample_average;
-
-        // if (i % 10 == 0) delay_buffer_g[delay_buffer_pos_g] = 255;
+        const fad_q15_t *in_run = runs[r].in;
+        fad_q15_t *out_run = runs[r].out;
+        int len = runs[r].len;
+
+        /* Ramp sample by sample until the delay settles, then finish the run a segment at a time.
+           Segments are shorter than the delay (by one more sample between samples, for the interpolation points),
+           so reads stay ahead of the writes they overlap */
+        while (len > 0)
+        {
+            int seg;
+            if (s->ramp_remaining > 0)
+            {
+                seg = s->ramp_remaining < len ? s->ramp_remaining : len;
+                delay_ramp(s, in_run, out_run, seg);
+            }
+            else
+            {
+                seg = (s->delay >> 16) - ((s->delay & 0xFFFF) ? 1 : 0);
+                if (seg > len) seg = len;
+                fad_delay_line_read_frac(&s->line, s->delay, out_run, seg, s->interp);
+                fad_delay_line_write(&s->line, in_run, seg);
+            }
+
+            in_run += seg;
+            out_run += seg;
+            len -= seg;
+        }
+    }
 
-        //Increment the delay buffer location
-        delay_buffer_pos_g++;
+}
 
-        //reset delay buffer pos
-        if (delay_buffer_pos_g == delay_size_g) delay_buffer_pos_g = 0;
+/* Convert a delay in ms to output samples, Q16, within what the delay line holds */
+static int32_t delay_ms_to_q16(const algo_delay_ctx_t *s, int delay_ms)
+{
+    return fad_delay_line_clamp(&s->line, fad_delay_line_ms(delay_ms, OUTPUT_FREQ));
+}
 
+void algo_delay_set_delay_ms(void *ctx, int delay_ms) {
+    algo_delay_ctx_t *s = ctx;
+    s->delay_target = delay_ms_to_q16(s, delay_ms);
+    if (s->delay_target == s->delay)
+    {
+        s->ramp_remaining = 0;
+        return;
     }
 
+    //Ramp from wherever the read position is now, even mid-ramp
+    s->delay_step = (s->delay_target - s->delay) / ALGO_DELAY_RAMP_LEN;
+    s->ramp_remaining = ALGO_DELAY_RAMP_LEN;
 }
 
-void algo_delay_init() { //fad_algo_init_params_t *params
-    //algo_delay_read_size_g = params->algo_delay_params.read_size;
-    //delay_size_g = params->algo_delay_params.delay;
-    delay_buffer_g = malloc(sizeof(uint8_t) * delay_size_g);
-    memset(delay_buffer_g, 128, delay_size_g);
-    delay_buffer_pos_g = 0;
+void algo_delay_init(void *ctx, fad_algo_init_params_t *params) {
+    algo_delay_ctx_t *s = ctx;
+    fad_delay_line_init(&s->line, params->algo_delay_params.storage, s->delay_buffer, ALGO_DELAY_BUFFER_SIZE);
+    s->interp = params->algo_delay_params.interp;
+    s->delay_target = delay_ms_to_q16(s, params->algo_delay_params.delay_ms);
+    s->delay = s->delay_target;
+    s->delay_step = 0;
+    s->ramp_remaining = 0;
 }
 
-void algo_delay_deinit() {
-    free(delay_buffer_g);
-}
\ No newline at end of file
+void algo_delay_update(void *ctx, fad_algo_init_params_t *params) {
+    algo_delay_set_delay_ms(ctx, params->algo_delay_params.delay_ms);
+}
+
+void algo_delay_deinit(void *ctx) {
+    // Nothing allocated
+}
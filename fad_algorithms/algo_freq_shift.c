@@ -5,96 +5,99 @@
  * Date: 3/25/2021
  *
  * Description:
- * This file returns the input signal at a different pitch, shifted by some target amount.
+ * This file returns the input signal with every frequency moved by a fixed number of Hz
+ * (single-sideband frequency shifting, for frequency-altered feedback).
+ *
+ * Two chains of allpass filters turn the input into a pair of signals 90 degrees
+ * apart over almost the whole band (an analytic signal, I + jQ). Multiplying it by a quadrature
+ * oscillator, I*cos - Q*sin, moves every component up by the oscillator frequency without the mirror
+ * image that plain ring modulation leaves. The oscillator is a fad_nco, so any shift is exact. The allpass coefficients are Olli Niemitalo's 8th-order
+ * design: each section is H(z) = (a^2 - z^-2) / (1 - a^2 z^-2), and the quadrature chain is delayed one sample.
+ *
+ * Signals inside the filters are held with ALGO_FREQ_SHIFT_GUARD extra fractional bits, and
+ * coefficients are Q30, so the sections near the unit circle do not lose precision.
  */
 
-
-
 #include "algo_freq_shift.h"
 #include "fad_defs.h"
-#include <stdlib.h>
-#include <math.h>
-
+#include "fad_fixed.h"
 
-//static int algo_freq_read_size_g = 512;
+/* Extra fractional bits of the signals inside the filters */
+#define ALGO_FREQ_SHIFT_GUARD 8
 
-//static int pitch_freq = 2;
+/* a^2 of each allpass section, Q30 */
+static const int32_t s_allpass_i[ALGO_FREQ_SHIFT_SECTIONS] = { 173686865, 787083823, 1015061512, 1063647745 };
+static const int32_t s_allpass_q[ALGO_FREQ_SHIFT_SECTIONS] = { 514752760, 940832443, 1048613677, 1071056671 };
 
+static inline int32_t mul_q30(int32_t a, int32_t b)
+{
+    return (int32_t)(((int64_t)a * b) >> 30);
+}
 
-//static int8_t[] shift_array_s;
-static int shift_array_period_s = 0;
-static int shift_array_pos_s = 0;
-int in_signal;
-int prev_signal=0;
-
+/* Run one sample through a chain of allpass sections */
+static inline int32_t allpass_chain(algo_freq_shift_allpass_t *chain, const int32_t *coef, int32_t x)
+{
+    for (int k = 0; k < ALGO_FREQ_SHIFT_SECTIONS; k++)
+    {
+        algo_freq_shift_allpass_t *ap = &chain[k];
+        int32_t y = mul_q30(coef[k], x + ap->y2) - ap->x2;
+        ap->x2 = ap->x1;
+        ap->x1 = x;
+        ap->y2 = ap->y1;
+        ap->y1 = y;
+        x = y;
+    }
+    return x;
+}
 
-void algo_freq_shift(uint16_t *in_buff, uint8_t *out_buff, uint16_t in_pos, uint16_t out_pos, int multisamples)
+void algo_freq_shift(void *ctx, const fad_span_t *in, const fad_span_t *out)
 {
-    
-    /* Need to multiply incoming data by sine wave to shift frequency. However, incoming data is centered around 2048 (ideally). 
-    If you simply multiply these together, there will be a leftover signal from the huge DC component of the incoming data.
-    You have to figure out how to mitigate this. Possible solution is to..
-        Subtract DC component from each sample before multiplying by the current sine position, then re-add the DC component
-            Considerations: Make sure the resulting DAC output value won't be negative after re-adding the DC component, because
-            the negative value will show up as a large positive value when it is converted back to an unsigned int.
-            */
-    
-    /* e.g.
-    for (int i = 0; i < algo_freq_read_size_g, i++) 
+    algo_freq_shift_ctx_t *s = ctx;
+    fad_span_run_t runs[FAD_SPAN_MAX_RUNS];
+    int num_runs = fad_span_runs(in, out, runs);
+
+    for (int r = 0; r < num_runs; r++)
     {
-        int val = in_buff[in_pos + i];
-        // shifting down
-        val -= 2048;
-        val = val * shift_array_s[shift_array_pos_s++];
+        const fad_q15_t *in_run = runs[r].in;
+        fad_q15_t *out_run = runs[r].out;
 
-        // manage circular buffer
-        if (shift_array_pos_s == shift_array_period_s) 
+        for (int i = 0; i < runs[r].len; i++)
         {
-            shift_array_pos_s = 0;
+            /* The input is DC blocked once by the app (fad_dc_block), so no DC becomes a tone at the shift frequency */
+            int32_t x = in_run[i] * (1 << ALGO_FREQ_SHIFT_GUARD);
+
+            /* Analytic signal: I leads Q by 90 degrees */
+            int32_t sig_i = allpass_chain(s->path_i, s_allpass_i, x);
+            int32_t sig_q = s->q_delay;
+            s->q_delay = allpass_chain(s->path_q, s_allpass_q, x);
+
+            /* Complex modulation by the oscillator */
+            fad_q15_t c, sn;
+            fad_nco_next_quad(&s->osc, &c, &sn);
+            int32_t y = (int32_t)(((int64_t)sig_i * c - (int64_t)sig_q * sn) >> 15);
+            out_run[i] = fad_sat_q15(fad_rshift_round(y, ALGO_FREQ_SHIFT_GUARD));
         }
-
-        // divide output to fit in DAC BEFORE re-adding DC component
-        val = val >> 10 // (not sure if 10 is correct)
-        val += 128;
-        out_buff[out_pos + i] = val;
-        
     }
-    */
-
-    for (int i = 0, j=0; i < ADC_BUFFER_SIZE; i++, j++)
-    {
-
-
-       // This program effectively halves the speed of the way
-       out_buff[out_pos+i] = (int) (in_buff[in_pos+j]) >> 4;
-        i++;
-        out_buff[out_pos+i] = (int) (in_buff[in_pos+j]) >> 4;
-        
-
-    }   
-    
 }
 
 
-void algo_freq_init()
-//void algo_freq_init(fad_algo_init_params_t *params)
+void algo_freq_init(void *ctx, fad_algo_init_params_t *params)
 {
-    //algo_freq_read_size_g = params->algo_freq_shift_params.read_size;
-    //int pitch_freq = params->algo_freq_shift_params.shift_amount;
-    /*
-    int period = ALARM_FREQ / pitch_freq;
-    shift_array_period_s = period;
+    algo_freq_shift_ctx_t *s = ctx;
+    s->shift_amount = params->algo_freq_shift_params.shift_amount;
 
-    shift_array = (uint32_t *) malloc(period * sizeof(uint32_t));
+    /* Negative shifts move down */
+    fad_nco_init(&s->osc, s->shift_amount, OUTPUT_FREQ, true);
 
-    for (double i = 0; i < period, i++)
+    s->q_delay = 0;
+    for (int k = 0; k < ALGO_FREQ_SHIFT_SECTIONS; k++)
     {
-        shift_array[i] = (int8_t) (127 * sin(i * 6.283 / period));
+        s->path_i[k] = (algo_freq_shift_allpass_t){0};
+        s->path_q[k] = (algo_freq_shift_allpass_t){0};
     }
-    */
 }
 
-void algo_freq_deinit()
+void algo_freq_deinit(void *ctx)
 {
-    //free(shift_array);
-}
\ No newline at end of file
+    // Nothing allocated
+}
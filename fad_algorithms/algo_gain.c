@@ -0,0 +1,39 @@
+/**
+ * algo_gain.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Scales the input signal and saturates to the Q15 range.
+ */
+
+#include "algo_gain.h"
+
+void algo_gain(void *ctx, const fad_span_t *in, const fad_span_t *out)
+{
+    algo_gain_ctx_t *s = ctx;
+    fad_span_run_t runs[FAD_SPAN_MAX_RUNS];
+    int num_runs = fad_span_runs(in, out, runs);
+
+    for (int r = 0; r < num_runs; r++)
+    {
+        const fad_q15_t *in_run = runs[r].in;
+        fad_q15_t *out_run = runs[r].out;
+
+        for (int i = 0; i < runs[r].len; i++)
+        {
+            out_run[i] = fad_sat_q15((in_run[i] * s->gain_q8) >> 8);
+        }
+    }
+}
+
+void algo_gain_init(void *ctx, fad_algo_init_params_t *params)
+{
+    algo_gain_ctx_t *s = ctx;
+    s->gain_q8 = (params->algo_gain_params.gain * 256) / 100;
+}
+
+void algo_gain_deinit(void *ctx)
+{
+    // Nothing allocated
+}
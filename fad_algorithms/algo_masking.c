@@ -5,95 +5,84 @@
  * Date: 10/12/2020
  *
  * Description:
- * This algo imitates the Edinburgh Masker by creating a triangular wave at the frequency of the user's voice signal.
+ * This algo imitates the Edinburgh Masker by creating a sawtooth or triangular wave at the frequency of the user's voice signal.
+ * The frequency comes from a pitch estimator in fad_pitch.h: YIN every block, or HPS every few blocks. The wave
+ * comes from a phase accumulator (fad_nco.h) whose step is set once per block, band-limited with PolyBLEP.
  */
 
 #include "algo_masking.h"
-#include "esp_log.h"
-#include "fft.h"
+#include "fad_log.h"
 #include "fad_defs.h"
-#include "driver/adc.h"
-#include "math.h"
+#include "fad_fixed.h"
+#include "fad_pitch.h"
 
 static const char* TAG = "algo_masking";
 
-/* Defines how many values the algorithm will read from the ADC buffer. Should always be at least half of buffer size. */
-static int s_algo_template_read_size = 1024; // was 512, then 2048
-
-float in_signal_count; //Increments for each sample taken
-float out_signal_count; //Increments for each sample taken
-bool in_sig_flag = true;  //Flag to indicate whether input signal is increasing or decreasing
-float current_ADC_val; // The ADC value for the current sample
-float threshold = 2048;  // The middle range of input values from the ADC
-float max_out_count=250; // Average frequency value of input. Tracks with the users voice
-float roll_AVG = 15; // Average over the last 15 ADC samples to determine frequency
-float DAC_out_val; // Output value to the DAC
-float MAX_DAC_OUT = 2048; // Maximum value that the DAC can output
-
 /*The Main program for the process of masking algorithm*/
-void algo_masking(uint16_t *in_buff, uint8_t *out_buff, uint16_t in_pos, uint16_t out_pos, int multisamples)
+void algo_masking(void *ctx, const fad_span_t *in, const fad_span_t *out)
 {
+    algo_masking_ctx_t *s = ctx;
 
     /**
-     * in_pos and out_pos point to the algorithm half of the buffer. Only ready and write to data in the half
-     * of the buffer designated by these positions
-     * 
+     * in and out describe this algorithm's block of samples. Only read and write data
+     * inside these spans.
+     *
      * The algorithm should have minimum side effects: try not to write to globals defined in other files, etc.
      */
-     
-     for(int i = 0; i < s_algo_template_read_size; i++) //This loop is the point of our troubles which is why we have the scaling for in_signal
-     {
-        if((i%15)==0) //scales the in signal count //v1.0 = 15
-        {    
-           in_signal_count++;
-        }
-          
-        out_signal_count++;
-
-        current_ADC_val = in_buff[in_pos + 1]; //Receives values from the ADC
-        
-        if((in_sig_flag && (current_ADC_val <= threshold)) || (!in_sig_flag && (current_ADC_val > threshold))) //Alternates flag when the ADC passes the threshold signifying a change in direction of the wave
+    fad_span_run_t runs[FAD_SPAN_MAX_RUNS];
+    int num_runs = fad_span_runs(in, out, runs);
+
+    /* Track the pitch first, so this block's output follows this block's voice */
+    bool estimated = true;
+    if (s->source == FAD_PITCH_HPS)
+    {
+        for (int r = 0; r < num_runs; r++)
         {
-            max_out_count = (max_out_count*((roll_AVG - 1)/roll_AVG)) + ((in_signal_count)/(roll_AVG));  //Updates a new average
-            in_signal_count = 0;    
-            in_sig_flag = !in_sig_flag;
+            fad_pitch_hps_write(&s->tracker.hps, runs[r].in, runs[r].len);
         }
-
-        DAC_out_val = ((((out_signal_count) / (2*max_out_count))) * MAX_DAC_OUT); //Calculates the value to be outputted to the DAC based off the average
-        
-        out_buff[out_pos + i] = (int)DAC_out_val; //Outputs to the DAC
-
-        if(out_signal_count >= (2*max_out_count)){
-            out_signal_count = 0;
+        estimated = fad_pitch_hps_estimate(&s->tracker.hps, &s->pitch);
+    }
+    else
+    {
+        for (int r = 0; r < num_runs; r++)
+        {
+            fad_pitch_yin_write(&s->tracker.yin, runs[r].in, runs[r].len);
         }
-        
-
-       
-      }
-
-           
-        /*Print out the outputs for Programmers to error check. Deletable once masker works*/
-    ESP_LOGI(TAG, "in signal count... %0.3f", in_signal_count);
-     ESP_LOGI(TAG, "out signal count... %0.3f", out_signal_count);
-     ESP_LOGI(TAG, "max out count... %0.3f", max_out_count);
-     ESP_LOGI(TAG, "currentADC... %0.3f", current_ADC_val);
-     ESP_LOGI(TAG, "Roll Average... %0.3f", roll_AVG);
-
-
-    //ESP_LOGI(ALGO_TAG, "running algo... %d", out_buff[out_pos]);
-    
+        fad_pitch_yin_estimate(&s->tracker.yin, &s->pitch);
+    }
+    if (estimated && s->pitch.voiced) //Only follow estimates that found a period, so silence and noise hold the last pitch
+    {
+        fad_nco_set_period(&s->osc, s->pitch.period);
+    }
+
+    for (int r = 0; r < num_runs; r++)
+    {
+        if (s->wave == FAD_MASKER_TRIANGLE) fad_nco_triangle(&s->osc, runs[r].out, runs[r].len);
+        else fad_nco_saw(&s->osc, runs[r].out, runs[r].len);
+        fad_gain_q15(runs[r].out, runs[r].out, runs[r].len, s->level, 0);
+    }
+
+    /*Print out the outputs for Programmers to error check. Deferred, so formatting stays off the audio path*/
+    FAD_LOGI(TAG, "pitch... %d Hz, confidence... %d%%", fad_pitch_hz(s->pitch.period) >> 16, (s->pitch.confidence * 100) >> 15);
 }
 
-void algo_masking_init()//fad_algo_init_params_t *params
+void algo_masking_init(void *ctx, fad_algo_init_params_t *params)
 {
-    //s_algo_template_read_size = params->algo_template_params.read_size;
-    //s_period = params->algo_template_params.period;
-    //float fft_input[s_algo_template_read_size];
-    //float fft_output[s_algo_template_read_size];
-    //fft_config_t *real_fft_plan = fft_init(s_algo_template_read_size, FFT_REAL, FFT_FORWARD, fft_input, fft_output);
+    algo_masking_ctx_t *s = ctx;
+    struct algo_masking_params_t *p = &params->algo_masking_params;
+    s->source = p->pitch;
+    if (s->source == FAD_PITCH_HPS) fad_pitch_hps_init(&s->tracker.hps, p->pitch_interval);
+    else fad_pitch_yin_init(&s->tracker.yin);
+    s->pitch.period = 500 << 16;
+    s->pitch.confidence = 0;
+    s->pitch.voiced = false;
+    s->wave = p->wave;
+    fad_nco_init(&s->osc, 0, OUTPUT_FREQ, false);
+    fad_nco_set_period(&s->osc, s->pitch.period);
+    s->level = ALGO_MASKING_LEVEL;
 }
 
-void algo_masking_deinit()
+void algo_masking_deinit(void *ctx)
 {
     // Undo any memory allocations here
 }
@@ -0,0 +1,82 @@
+/**
+ * algo_multitap.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Multi-tap delay. Each pass reads a chunk of every tap from the shared line and accumulates it
+ * with the tap's gain, then stores the same chunk of input. A chunk is never longer than the
+ * shortest tap, so every value read was stored by an earlier pass.
+ */
+
+#include "algo_multitap.h"
+
+/* Mix one chunk of every tap into out, then store the chunk of input */
+static void multitap_chunk(algo_multitap_ctx_t *s, const fad_q15_t *in, fad_q15_t *out, int len)
+{
+    int32_t acc[ALGO_MULTITAP_CHUNK] = {0};
+    fad_q15_t tap[ALGO_MULTITAP_CHUNK];
+
+    for (int t = 0; t < s->num_taps; t++)
+    {
+        fad_delay_line_read_frac(&s->line, s->tap_delay[t], tap, len, FAD_DELAY_INTERP_LINEAR);
+        for (int i = 0; i < len; i++)
+        {
+            acc[i] = fad_mac_q15(acc[i], tap[i], s->tap_gain[t]);
+        }
+    }
+
+    for (int i = 0; i < len; i++)
+    {
+        out[i] = fad_sat_q15(fad_rshift_round(acc[i], 15));
+    }
+
+    fad_delay_line_write(&s->line, in, len);
+}
+
+void algo_multitap(void *ctx, const fad_span_t *in, const fad_span_t *out)
+{
+    algo_multitap_ctx_t *s = ctx;
+    fad_span_run_t runs[FAD_SPAN_MAX_RUNS];
+    int num_runs = fad_span_runs(in, out, runs);
+
+    int chunk = s->min_delay < ALGO_MULTITAP_CHUNK ? s->min_delay : ALGO_MULTITAP_CHUNK;
+
+    for (int r = 0; r < num_runs; r++)
+    {
+        for (int i = 0; i < runs[r].len; i += chunk)
+        {
+            int len = runs[r].len - i < chunk ? runs[r].len - i : chunk;
+            multitap_chunk(s, runs[r].in + i, runs[r].out + i, len);
+        }
+    }
+}
+
+void algo_multitap_init(void *ctx, fad_algo_init_params_t *params)
+{
+    algo_multitap_ctx_t *s = ctx;
+    struct algo_multitap_params_t *p = &params->algo_multitap_params;
+
+    fad_delay_line_init(&s->line, p->storage, s->delay_buffer, ALGO_MULTITAP_BUFFER_SIZE);
+
+    s->num_taps = p->num_taps;
+    if (s->num_taps > ALGO_MULTITAP_MAX_TAPS) s->num_taps = ALGO_MULTITAP_MAX_TAPS;
+    if (s->num_taps < 1) s->num_taps = 1;
+
+    /* A tap between samples reads one sample further ahead, so it allows one sample less per pass */
+    s->min_delay = s->line.max_delay;
+    for (int t = 0; t < s->num_taps; t++)
+    {
+        int32_t delay = fad_delay_line_clamp(&s->line, fad_delay_line_ms(p->tap_ms[t], OUTPUT_FREQ));
+        s->tap_delay[t] = delay;
+        int whole = (delay >> 16) - ((delay & 0xFFFF) ? 1 : 0);
+        if (whole < s->min_delay) s->min_delay = whole;
+
+        s->tap_gain[t] = fad_sat_q15((p->tap_gain[t] * 32768) / 100);
+    }
+}
+
+void algo_multitap_deinit(void *ctx)
+{
+    // Nothing allocated
+}
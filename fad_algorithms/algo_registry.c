@@ -0,0 +1,188 @@
+/**
+ * algo_registry.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * The algorithm table. To add an algorithm, add its type to fad_algo_type_t and its entry here.
+ * Every entry and mode uses FAD_BLOCK_SIZE as its read_size; algorithms that want a longer analysis window
+ * keep one in their state. Add the entry's state to fad_algo_state_t in algo_registry.h so the arena banks
+ * are large enough.
+ */
+
+#include "algo_registry.h"
+
+const fad_algo_desc_t fad_algo_registry[FAD_ALGO_COUNT] = {
+    [FAD_ALGO_DELAY] = {
+        .name = "Delay",
+        .init = algo_delay_init,
+        .process = algo_delay,
+        .deinit = algo_delay_deinit,
+        .update = algo_delay_update,
+        .read_size = FAD_BLOCK_SIZE,
+        .state_size = ALGO_DELAY_STATE_SIZE,
+        .mode_params = {
+            [FAD_ALGO_MODE_1] = { .algo_delay_params = { .read_size = FAD_BLOCK_SIZE, .delay_ms = 450 } },
+            [FAD_ALGO_MODE_2] = { .algo_delay_params = { .read_size = FAD_BLOCK_SIZE, .delay_ms = 600 } },
+            [FAD_ALGO_MODE_3] = { .algo_delay_params = { .read_size = FAD_BLOCK_SIZE, .delay_ms = 800 } },
+        },
+    },
+    [FAD_ALGO_FREQ_SHIFT] = {
+        .name = "Frequency Shift",
+        .init = algo_freq_init,
+        .process = algo_freq_shift,
+        .deinit = algo_freq_deinit,
+        .read_size = FAD_BLOCK_SIZE,
+        .state_size = ALGO_FREQ_SHIFT_STATE_SIZE,
+        .gated = true,
+        .mode_params = {
+            [FAD_ALGO_MODE_1] = { .algo_freq_shift_params = { .read_size = FAD_BLOCK_SIZE, .shift_amount = 100 } },
+            [FAD_ALGO_MODE_2] = { .algo_freq_shift_params = { .read_size = FAD_BLOCK_SIZE, .shift_amount = 200 } },
+            [FAD_ALGO_MODE_3] = { .algo_freq_shift_params = { .read_size = FAD_BLOCK_SIZE, .shift_amount = 400 } },
+        },
+    },
+    [FAD_ALGO_MASKING] = {
+        .name = "Masking",
+        .init = algo_masking_init,
+        .process = algo_masking,
+        .deinit = algo_masking_deinit,
+        .read_size = FAD_BLOCK_SIZE,
+        .state_size = ALGO_MASKING_STATE_SIZE,
+        .gated = true,
+        /* Mode 1 follows YIN with a triangle, mode 2 HPS every block with a sawtooth, and mode 3 HPS every fourth block, a quarter of the cost, with a triangle */
+        .mode_params = {
+            [FAD_ALGO_MODE_1] = { .algo_masking_params = { .read_size = FAD_BLOCK_SIZE, .pitch = FAD_PITCH_YIN, .wave = FAD_MASKER_TRIANGLE } },
+            [FAD_ALGO_MODE_2] = { .algo_masking_params = { .read_size = FAD_BLOCK_SIZE, .pitch = FAD_PITCH_HPS, .pitch_interval = 1 } },
+            [FAD_ALGO_MODE_3] = { .algo_masking_params = { .read_size = FAD_BLOCK_SIZE, .pitch = FAD_PITCH_HPS, .pitch_interval = 4, .wave = FAD_MASKER_TRIANGLE } },
+        },
+    },
+    [FAD_ALGO_TEMPLATE] = {
+        .name = "Template",
+        .init = algo_template_init,
+        .process = algo_template,
+        .deinit = algo_template_deinit,
+        .read_size = FAD_BLOCK_SIZE,
+        .state_size = ALGO_TEMPLATE_STATE_SIZE,
+        .mode_params = {
+            [FAD_ALGO_MODE_1] = { .algo_template_params = { .read_size = FAD_BLOCK_SIZE, .period = 8 } },
+            [FAD_ALGO_MODE_2] = { .algo_template_params = { .read_size = FAD_BLOCK_SIZE, .period = 16 } },
+            [FAD_ALGO_MODE_3] = { .algo_template_params = { .read_size = FAD_BLOCK_SIZE, .period = 64 } },
+        },
+    },
+    [FAD_ALGO_WHITE] = {
+        .name = "White Noise",
+        .init = algo_white_init,
+        .process = algo_white,
+        .deinit = algo_white_deinit,
+        .read_size = FAD_BLOCK_SIZE,
+        .state_size = ALGO_WHITE_STATE_SIZE,
+        .gated = true,
+        .mode_params = {
+            [FAD_ALGO_MODE_1] = { .algo_white_params = { .read_size = FAD_BLOCK_SIZE } },
+            [FAD_ALGO_MODE_2] = { .algo_white_params = { .read_size = FAD_BLOCK_SIZE } },
+            [FAD_ALGO_MODE_3] = { .algo_white_params = { .read_size = FAD_BLOCK_SIZE } },
+        },
+    },
+    [FAD_ALGO_GAIN] = {
+        .name = "Gain",
+        .init = algo_gain_init,
+        .process = algo_gain,
+        .deinit = algo_gain_deinit,
+        .read_size = FAD_BLOCK_SIZE,
+        .state_size = ALGO_GAIN_STATE_SIZE,
+        .mode_params = {
+            [FAD_ALGO_MODE_1] = { .algo_gain_params = { .read_size = FAD_BLOCK_SIZE, .gain = 100 } },
+            [FAD_ALGO_MODE_2] = { .algo_gain_params = { .read_size = FAD_BLOCK_SIZE, .gain = 150 } },
+            [FAD_ALGO_MODE_3] = { .algo_gain_params = { .read_size = FAD_BLOCK_SIZE, .gain = 200 } },
+        },
+    },
+    [FAD_ALGO_DELAY_LONG] = {
+        .name = "Long Delay",
+        .init = algo_delay_init,
+        .process = algo_delay,
+        .deinit = algo_delay_deinit,
+        .update = algo_delay_update,
+        .read_size = FAD_BLOCK_SIZE,
+        .state_size = ALGO_DELAY_STATE_SIZE,
+        .mode_params = {
+            [FAD_ALGO_MODE_1] = { .algo_delay_params = { .read_size = FAD_BLOCK_SIZE, .delay_ms = 1000, .storage = FAD_DELAY_LINE_ADPCM } },
+            [FAD_ALGO_MODE_2] = { .algo_delay_params = { .read_size = FAD_BLOCK_SIZE, .delay_ms = 1200, .storage = FAD_DELAY_LINE_ADPCM } },
+            [FAD_ALGO_MODE_3] = { .algo_delay_params = { .read_size = FAD_BLOCK_SIZE, .delay_ms = 1400, .storage = FAD_DELAY_LINE_ADPCM } },
+        },
+    },
+    [FAD_ALGO_DELAY_12BIT] = {
+        .name = "Delay (12-bit)",
+        .init = algo_delay_init,
+        .process = algo_delay,
+        .deinit = algo_delay_deinit,
+        .update = algo_delay_update,
+        .read_size = FAD_BLOCK_SIZE,
+        .state_size = ALGO_DELAY_STATE_SIZE,
+        .mode_params = {
+            [FAD_ALGO_MODE_1] = { .algo_delay_params = { .read_size = FAD_BLOCK_SIZE, .delay_ms = 300, .storage = FAD_DELAY_LINE_PACKED12, .interp = FAD_DELAY_INTERP_LAGRANGE } },
+            [FAD_ALGO_MODE_2] = { .algo_delay_params = { .read_size = FAD_BLOCK_SIZE, .delay_ms = 400, .storage = FAD_DELAY_LINE_PACKED12, .interp = FAD_DELAY_INTERP_LAGRANGE } },
+            [FAD_ALGO_MODE_3] = { .algo_delay_params = { .read_size = FAD_BLOCK_SIZE, .delay_ms = 500, .storage = FAD_DELAY_LINE_PACKED12, .interp = FAD_DELAY_INTERP_LAGRANGE } },
+        },
+    },
+    [FAD_ALGO_MULTITAP] = {
+        .name = "Multi-tap Delay",
+        .init = algo_multitap_init,
+        .process = algo_multitap,
+        .deinit = algo_multitap_deinit,
+        .read_size = FAD_BLOCK_SIZE,
+        .state_size = ALGO_MULTITAP_STATE_SIZE,
+        .mode_params = {
+            [FAD_ALGO_MODE_1] = { .algo_multitap_params = { .read_size = FAD_BLOCK_SIZE, .num_taps = 3, .tap_ms = { 50, 100, 150 }, .tap_gain = { 60, 40, 20 } } },
+            [FAD_ALGO_MODE_2] = { .algo_multitap_params = { .read_size = FAD_BLOCK_SIZE, .num_taps = 3, .tap_ms = { 100, 200, 300 }, .tap_gain = { 70, 50, 30 } } },
+            [FAD_ALGO_MODE_3] = { .algo_multitap_params = { .read_size = FAD_BLOCK_SIZE, .num_taps = 4, .tap_ms = { 150, 300, 450, 600 }, .tap_gain = { 70, 50, 35, 25 } } },
+        },
+    },
+    [FAD_ALGO_WSOLA] = {
+        .name = "Pitch Shift (WSOLA)",
+        .init = algo_wsola_init,
+        .process = algo_wsola,
+        .deinit = algo_wsola_deinit,
+        .update = algo_wsola_update,
+        .read_size = FAD_BLOCK_SIZE,
+        .state_size = ALGO_WSOLA_STATE_SIZE,
+        .gated = true,
+        .mode_params = {
+            [FAD_ALGO_MODE_1] = { .algo_wsola_params = { .read_size = FAD_BLOCK_SIZE, .cents = -300 } },
+            [FAD_ALGO_MODE_2] = { .algo_wsola_params = { .read_size = FAD_BLOCK_SIZE, .cents = -600 } },
+            [FAD_ALGO_MODE_3] = { .algo_wsola_params = { .read_size = FAD_BLOCK_SIZE, .cents = -1200 } },
+        },
+    },
+    [FAD_ALGO_VOCODER] = {
+        .name = "Pitch Shift (Vocoder)",
+        .init = algo_vocoder_init,
+        .process = algo_vocoder,
+        .deinit = algo_vocoder_deinit,
+        .read_size = FAD_BLOCK_SIZE,
+        .state_size = ALGO_VOCODER_STATE_SIZE,
+        .gated = true,
+        /* Every mode shifts the same. Mode 2 trades latency for frequency resolution; mode 3 overlaps its frames twice as much, for fewer artifacts at twice the transforms */
+        .mode_params = {
+            [FAD_ALGO_MODE_1] = { .algo_vocoder_params = { .read_size = FAD_BLOCK_SIZE, .cents = -600, .frame_size = 128, .hop = 32 } },
+            [FAD_ALGO_MODE_2] = { .algo_vocoder_params = { .read_size = FAD_BLOCK_SIZE, .cents = -600, .frame_size = 256, .hop = 64 } },
+            [FAD_ALGO_MODE_3] = { .algo_vocoder_params = { .read_size = FAD_BLOCK_SIZE, .cents = -600, .frame_size = 256, .hop = 32 } },
+        },
+    },
+    [FAD_ALGO_DELAY_FREQ_SHIFT] = {
+        .name = "Delay + Frequency Shift",
+        .read_size = FAD_BLOCK_SIZE,
+        .num_stages = 2,
+        .stages = { FAD_ALGO_DELAY, FAD_ALGO_FREQ_SHIFT },
+    },
+};
+
+const fad_algo_desc_t *fad_algo_get_desc(fad_algo_type_t type)
+{
+    if ((unsigned)type >= FAD_ALGO_COUNT) return NULL;
+    return &fad_algo_registry[type];
+}
+
+const fad_algo_init_params_t *fad_algo_get_params(const fad_algo_desc_t *desc, fad_algo_mode_t mode)
+{
+    if ((unsigned)mode >= FAD_ALGO_MODE_COUNT) mode = FAD_ALGO_MODE_1;
+    return &desc->mode_params[mode];
+}
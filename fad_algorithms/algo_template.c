@@ -9,60 +9,47 @@
  */
 
 #include "algo_template.h"
-#include "esp_log.h"
+#include "fad_log.h"
+#include <string.h>
 
 #define ALGO_TAG "ALGO_TEMPLATE"
 
-/* Defines how many values the algorithm will read from the ADC buffer. Should always be at least half of buffer size. */
-static int s_algo_template_read_size = 512;
-
-/* Determines the period of the square wave */
-static int s_period = 30;
-
-void algo_template(uint16_t *in_buff, uint8_t *out_buff, uint16_t in_pos, uint16_t out_pos, int multisamples)
+void algo_template(void *ctx, const fad_span_t *in, const fad_span_t *out)
 {
+    algo_template_ctx_t *s = ctx;
+    (void) s; // only used by the square wave below
 
     /**
-     * in_pos and out_pos point to the algorithm half of the buffer. Only ready and write to data in the half
-     * of the buffer designated by these positions
+     * in and out describe this algorithm's block of samples. Only read and write data
+     * inside these spans. fad_span_runs splits them into pieces that are contiguous in both, so the
+     * inner loop never has to check for the end of the circular buffers.
      * 
      * The algorithm should have minimum side effects: try not to write to globals defined in other files, etc.
+     * Keep all state in ctx so that several instances can run side by side.
      */
 
     /* This algorithm simply outputs the input to the ADC */
 
-    //ESP_LOGI(ALGO_TAG, "s_algo_template_read_size = %d", s_algo_template_read_size);
+    fad_span_run_t runs[FAD_SPAN_MAX_RUNS];
+    int num_runs = fad_span_runs(in, out, runs);
 
-    for (int i = 0; i < s_algo_template_read_size / multisamples; i++)
+    for (int r = 0; r < num_runs; r++)
     {
-        //uint16_t avg = 0;
-        //the following section averages the multisampled ADC data so that each DAC buffer space will have one corresponding ADC value
-
-        //for (int j = 0; j < multisamples; j++)
-        //{
-         //   avg += in_buff[in_pos + (i * multisamples) + j];
-        //}
-
-        //avg = avg / multisamples;
-        /** END SECTION **/
-
-        //uint8_t val = 0;
-        //if ((i / s_period) % 2 == 0) val = (avg >> 5) + 100; // Generates square wave with freq of 11k / period
-        
-        uint8_t val = in_buff[in_pos + i];
-        out_buff[out_pos + i] = val;
-
+        //for (int i = 0; i < runs[r].len; i++)
+        //    if ((i / s->period) % 2 == 0) runs[r].out[i] = (runs[r].in[i] >> 1) + FAD_Q15(0.05); // Generates square wave with freq of 11k / period
+        memcpy(runs[r].out, runs[r].in, runs[r].len * sizeof(fad_q15_t));
     }
-     ESP_LOGI(ALGO_TAG, "running algo... %d", out_buff[out_pos]);
+
+     FAD_LOGD(ALGO_TAG, "running algo... %d", out->seg[0][0]);
 }
 
-void algo_template_init(fad_algo_init_params_t *params)
+void algo_template_init(void *ctx, fad_algo_init_params_t *params)
 {
-    s_algo_template_read_size = params->algo_template_params.read_size;
-    s_period = params->algo_template_params.period;
+    algo_template_ctx_t *s = ctx;
+    s->period = params->algo_template_params.period;
 }
 
-void algo_template_deinit()
+void algo_template_deinit(void *ctx)
 {
     // Undo any memory allocations here
 }
\ No newline at end of file
@@ -0,0 +1,192 @@
+/**
+ * algo_vocoder.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Phase-vocoder pitch shift, streaming. Each input sample goes into in_fifo and each output sample
+ * comes from out_fifo, so the output lags by frame_size samples. Whenever in_fifo fills, one
+ * frame is analysed, shifted and synthesized, its first hop samples of overlap-add are finished into
+ * out_fifo, and in_fifo keeps its last frame_size - hop samples for the next frame.
+ *
+ * The transforms are float (fft.c), so this runs at the FFT's precision; samples enter and leave as Q15.
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <string.h>
+#include "algo_vocoder.h"
+
+#define VOCODER_PI 3.14159265358979f
+#define VOCODER_TWO_PI (2.0f * VOCODER_PI)
+
+/* Wrap a phase to [-pi, pi] */
+static inline float wrap_phase(float phase)
+{
+    return phase - VOCODER_TWO_PI * rintf(phase / VOCODER_TWO_PI);
+}
+
+/* Add a bin to the packed rfft spectrum. The imaginary parts of DC and Nyquist are dropped */
+static inline void spectrum_add(float *spectrum, int n, int k, float re, float im)
+{
+    if (k == 0) spectrum[0] += re;
+    else if (k == n / 2) spectrum[1] += re;
+    else
+    {
+        spectrum[2 * k] += re;
+        spectrum[2 * k + 1] += im;
+    }
+}
+
+/* Analyse, shift and synthesize the frame in in_fifo, and finish the next hop samples of output */
+static void vocoder_frame(algo_vocoder_ctx_t *s)
+{
+    const int n = s->frame_size;
+    const int bins = n / 2 + 1;
+    const float osamp = (float)n / s->hop;
+    const float expected = VOCODER_TWO_PI * s->hop / n;    // Phase advance per frame of a partial centered on bin 1
+
+    for (int i = 0; i < n; i++)
+    {
+        s->frame[i] = s->in_fifo[i] * s->window[i] * (1.0f / 32768.0f);
+    }
+    fft_execute(&s->fft_fwd);
+
+    /* Analysis: magnitude and phase of each bin */
+    for (int k = 0; k < bins; k++)
+    {
+        float re, im;
+        if (k == 0) { re = s->spectrum[0]; im = 0.0f; }
+        else if (k == n / 2) { re = s->spectrum[1]; im = 0.0f; }
+        else { re = s->spectrum[2 * k]; im = s->spectrum[2 * k + 1]; }
+
+        s->ana_mag[k] = sqrtf(re * re + im * im);
+        s->ana_phase[k] = atan2f(im, re);
+    }
+
+    /*
+     * Synthesis: each peak moves with the bins around it, up to halfway to the next peak, so the shape
+     * and relative phases of its window lobe are kept. The region is shifted by whole bins to the
+     * nearest bin of the shifted frequency, and rotated by a phase that advances each frame by the
+     * difference between the shifted and the true frequency, so the partial comes out at exactly its
+     * frequency times the ratio. A peak carries on the rotation of the region it lay in last frame.
+     */
+    memset(s->spectrum, 0, n * sizeof(float));
+    int lo = 0;
+    for (int p = 0; p < bins; p++)
+    {
+        float m = s->ana_mag[p];
+        bool peak = m > 0.0f &&
+                    (p < 1 || m > s->ana_mag[p - 1]) && (p < 2 || m > s->ana_mag[p - 2]) &&
+                    (p + 1 >= bins || m >= s->ana_mag[p + 1]) && (p + 2 >= bins || m >= s->ana_mag[p + 2]);
+        if (!peak) continue;
+
+        /* The region ends halfway to the next peak, or at Nyquist */
+        int next = p + 1;
+        while (next < bins)
+        {
+            float mn = s->ana_mag[next];
+            if (mn > s->ana_mag[next - 1] && (next < 2 || mn > s->ana_mag[next - 2]) &&
+                (next + 1 >= bins || mn >= s->ana_mag[next + 1]) && (next + 2 >= bins || mn >= s->ana_mag[next + 2])) break;
+            next++;
+        }
+        int hi = next < bins ? (p + next) / 2 : bins - 1;
+
+        /* True frequency of the peak in bins, from its phase advance since the last frame */
+        float dev = wrap_phase(s->ana_phase[p] - s->last_phase[p] - p * expected);
+        float freq = p + dev * osamp / VOCODER_TWO_PI;
+
+        int shift = (int)lrintf(freq * s->ratio) - p;
+        float rot = wrap_phase(s->rot[p] + expected * freq * (s->ratio - 1.0f));
+
+        for (int k = lo; k <= hi; k++)
+        {
+            int t = k + shift;
+            if (t >= 0 && t < bins)
+            {
+                float phase = s->ana_phase[k] + rot;
+                spectrum_add(s->spectrum, n, t, s->ana_mag[k] * cosf(phase), s->ana_mag[k] * sinf(phase));
+            }
+            s->rot[k] = rot;
+        }
+
+        lo = hi + 1;
+        p = next - 1;
+    }
+    memcpy(s->last_phase, s->ana_phase, bins * sizeof(float));
+    fft_execute(&s->fft_inv);
+
+    /* Window again and overlap-add. Squared Hann windows a quarter frame or less apart sum to 3 / 8 of the overlap */
+    const float gain = 8.0f / (3.0f * osamp) * 32768.0f;
+    for (int i = 0; i < n; i++)
+    {
+        s->accum[i] += s->frame[i] * s->window[i] * gain;
+    }
+
+    for (int i = 0; i < s->hop; i++)
+    {
+        s->out_fifo[i] = fad_sat_q15((int32_t)lrintf(s->accum[i]));
+    }
+    memmove(s->accum, s->accum + s->hop, (n - s->hop) * sizeof(float));
+    memset(s->accum + n - s->hop, 0, s->hop * sizeof(float));
+    memmove(s->in_fifo, s->in_fifo + s->hop, (n - s->hop) * sizeof(fad_q15_t));
+}
+
+void algo_vocoder(void *ctx, const fad_span_t *in, const fad_span_t *out)
+{
+    algo_vocoder_ctx_t *s = ctx;
+    fad_span_run_t runs[FAD_SPAN_MAX_RUNS];
+    int num_runs = fad_span_runs(in, out, runs);
+    const int latency = s->frame_size - s->hop;
+
+    for (int r = 0; r < num_runs; r++)
+    {
+        for (int i = 0; i < runs[r].len; i++)
+        {
+            s->in_fifo[s->fill] = runs[r].in[i];
+            runs[r].out[i] = s->out_fifo[s->fill - latency];
+
+            if (++s->fill == s->frame_size)
+            {
+                vocoder_frame(s);
+                s->fill = latency;
+            }
+        }
+    }
+}
+
+void algo_vocoder_init(void *ctx, fad_algo_init_params_t *params)
+{
+    algo_vocoder_ctx_t *s = ctx;
+    struct algo_vocoder_params_t *p = &params->algo_vocoder_params;
+
+    /* The frame must be a power of two that fits the buffers, and overlap at least 4 times for the window gain */
+    int n = p->frame_size;
+    if (n > ALGO_VOCODER_MAX_FRAME || n < 16 || (n & (n - 1)) != 0) n = ALGO_VOCODER_MAX_FRAME;
+    int hop = p->hop;
+    if (hop < 1 || hop > n / 4) hop = n / 4;
+
+    s->frame_size = n;
+    s->hop = hop;
+    s->fill = n - hop;
+    s->ratio = exp2f(p->cents / 1200.0f);
+
+    fft_init_static(&s->fft_fwd, n, FFT_REAL, FFT_FORWARD, s->frame, s->spectrum, s->twiddles);
+    fft_init_static(&s->fft_inv, n, FFT_REAL, FFT_BACKWARD, s->spectrum, s->frame, s->twiddles);
+
+    for (int i = 0; i < n; i++)
+    {
+        s->window[i] = 0.5f - 0.5f * cosf(VOCODER_TWO_PI * i / n);
+    }
+
+    memset(s->in_fifo, 0, sizeof(s->in_fifo));
+    memset(s->out_fifo, 0, sizeof(s->out_fifo));
+    memset(s->accum, 0, sizeof(s->accum));
+    memset(s->last_phase, 0, sizeof(s->last_phase));
+    memset(s->rot, 0, sizeof(s->rot));
+}
+
+void algo_vocoder_deinit(void *ctx)
+{
+    // Nothing allocated
+}
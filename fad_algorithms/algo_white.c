@@ -12,38 +12,43 @@
 #include "algo_white.h"
 #include "esp_system.h"
 #include "esp_log.h"
+#include "fad_fixed.h"
 
-void algo_white(uint16_t *in_buff, uint8_t *out_buff, uint16_t in_pos, uint16_t out_pos, int multisamples)
+void algo_white(void *ctx, const fad_span_t *in, const fad_span_t *out)
 {
-	/* quick scan for max/min */
-	uint16_t max = 0;
-	uint16_t min = 0xFFFF;
-	for (int i = 0; i < 64; i++)
-	{
-		max = ( max < in_buff[i] ) ? in_buff[i] : max;
-		min = ( min > in_buff[i] ) ? in_buff[i] : min;
-	}
-
-	uint16_t diff = (max - min) >> 4; /* Bit shift 4 times to turn 12 bit ADC input to 8 bit char */
-	// ESP_LOGI("ALGO", "diff: %d", diff);
-	out_buff[0] = 0x7F;
+	algo_white_ctx_t *s = ctx;
+	fad_span_run_t runs[FAD_SPAN_MAX_RUNS];
+	int num_runs = fad_span_runs(in, out, runs);
 
+	fad_q15_t prev = s->prev;
 
-	uint16_t next_avg;
-	uint16_t cur_avg;
-
-	for (int i = 0; i < ( algo_white_size / multisamples ) - 1; i++)
+	for (int r = 0; r < num_runs; r++)
 	{
-		next_avg = in_buff[i + 1];
-		cur_avg = in_buff[i];
-		/* to center input wave around 0 plus some, we effectively take discrete derivative, then discrete integral */
-		int8_t discrete_diff = (int8_t)((next_avg - cur_avg) >> 4);
-
-		out_buff[i + 1] = 0x7F + (((char)esp_random() * discrete_diff) >> 8);
+		const fad_q15_t *in_run = runs[r].in;
+		fad_q15_t *out_run = runs[r].out;
+
+		for (int i = 0; i < runs[r].len; i++)
+		{
+			/* to center input wave around 0 plus some, we effectively take discrete derivative, then discrete integral.
+			 * The difference of two Q15 values spans twice the Q15 range, so halve it */
+			fad_q15_t discrete_diff = (in_run[i] - prev) >> 1;
+			prev = in_run[i];
+
+			fad_q15_t val = fad_mul_q15((fad_q15_t)esp_random(), discrete_diff);
+			out_run[i] = val;
+		}
 	}
+
+	s->prev = prev;
+}
+
+void algo_white_init(void *ctx, fad_algo_init_params_t *params)
+{
+	algo_white_ctx_t *s = ctx;
+	s->prev = 0;
 }
 
-void algo_white_init(int algo_size)
+void algo_white_deinit(void *ctx)
 {
-	algo_white_size = algo_size;
+	// Nothing allocated
 }
\ No newline at end of file
@@ -0,0 +1,187 @@
+/**
+ * algo_wsola.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * WSOLA pitch shift. Each output sample stores one input sample in the ring, then reads the ring at
+ * the read delay with linear interpolation. The delay moves by 1 - ratio per sample; when it leaves
+ * its range a search picks the new delay and the output fades to it. See algo_wsola.h for the bounds.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "algo_wsola.h"
+
+#define RING_MASK (ALGO_WSOLA_BUFFER_LEN - 1)
+
+#if (ALGO_WSOLA_BUFFER_LEN & RING_MASK) != 0 || ALGO_WSOLA_BUFFER_LEN <= ALGO_WSOLA_MAX_DELAY + 1
+#error "ALGO_WSOLA_BUFFER_LEN must be a power of two longer than ALGO_WSOLA_MAX_DELAY + 1"
+#endif
+
+/* The sample delay samples behind the write position */
+static inline int32_t ring_at(const algo_wsola_ctx_t *s, int delay)
+{
+    return s->ring[(s->write_pos - delay) & RING_MASK];
+}
+
+/* Read at a Q16 delay, interpolating linearly between the samples either side */
+static inline int32_t ring_read(const algo_wsola_ctx_t *s, int32_t delay)
+{
+    int whole = delay >> 16;
+    int32_t a = ring_at(s, whole);
+    int32_t b = ring_at(s, whole + 1);
+    return a + (int32_t)(((int64_t)(b - a) * (delay & 0xFFFF)) >> 16);
+}
+
+/*
+ * Similarity of the candidate waveform at delay cand to the waveform at delay ref, over every step-th
+ * sample: the correlation squared (keeping its sign) over the candidate's energy, so a loud candidate
+ * is not preferred over one of the same shape. Sums are Q30; the correlation keeps 29 bits after its
+ * shift, so its square fits in 64 bits.
+ */
+static int64_t similarity(const algo_wsola_ctx_t *s, int ref, int cand, int step)
+{
+    int64_t corr = 0;
+    int64_t energy = 0;
+    for (int k = 0; k < ALGO_WSOLA_OVERLAP; k += step)
+    {
+        int32_t c = ring_at(s, cand - k);
+        corr += ring_at(s, ref - k) * c;
+        energy += c * c;
+    }
+
+    corr >>= 8;
+    int64_t sign = corr < 0 ? -1 : 1;
+    return sign * corr * corr / ((energy >> 16) + 1);
+}
+
+/* Find the delay, within ALGO_WSOLA_SEARCH of ref + jump, whose waveform best matches the waveform at ref */
+static int search(const algo_wsola_ctx_t *s, int ref, int jump)
+{
+    int nominal = ref + jump;
+
+    /* Coarse pass: every ALGO_WSOLA_DECIMATE-th lag over every ALGO_WSOLA_DECIMATE-th sample */
+    int best = nominal;
+    int64_t best_score = INT64_MIN;
+    for (int lag = -ALGO_WSOLA_SEARCH; lag <= ALGO_WSOLA_SEARCH; lag += ALGO_WSOLA_DECIMATE)
+    {
+        int64_t score = similarity(s, ref, nominal + lag, ALGO_WSOLA_DECIMATE);
+        if (score > best_score)
+        {
+            best_score = score;
+            best = nominal + lag;
+        }
+    }
+
+    /* Fine pass: every lag the coarse pass stepped over near its best, over every sample */
+    int center = best;
+    best_score = INT64_MIN;
+    for (int lag = -(ALGO_WSOLA_DECIMATE - 1); lag <= ALGO_WSOLA_DECIMATE - 1; lag++)
+    {
+        int cand = center + lag;
+        if (cand < nominal - ALGO_WSOLA_SEARCH || cand > nominal + ALGO_WSOLA_SEARCH) continue;
+
+        int64_t score = similarity(s, ref, cand, 1);
+        if (score > best_score)
+        {
+            best_score = score;
+            best = cand;
+        }
+    }
+
+    return best;
+}
+
+/* Start a crossfade if the read delay has left its range */
+static void wsola_check(algo_wsola_ctx_t *s)
+{
+    int jump;
+    if (s->ratio > 0x10000 && s->delay < (ALGO_WSOLA_LOW_DELAY << 16)) jump = ALGO_WSOLA_JUMP;
+    else if (s->ratio < 0x10000 && s->delay > (ALGO_WSOLA_HIGH_DELAY << 16)) jump = -ALGO_WSOLA_JUMP;
+    else return;
+
+    /* The new position keeps the fraction of the old, so both advance in step */
+    int target = search(s, s->delay >> 16, jump);
+    s->next_delay = ((int32_t)target << 16) | (s->delay & 0xFFFF);
+    s->fade_pos = 0;
+}
+
+void algo_wsola(void *ctx, const fad_span_t *in, const fad_span_t *out)
+{
+    algo_wsola_ctx_t *s = ctx;
+    fad_span_run_t runs[FAD_SPAN_MAX_RUNS];
+    int num_runs = fad_span_runs(in, out, runs);
+
+    for (int r = 0; r < num_runs; r++)
+    {
+        for (int i = 0; i < runs[r].len; i++)
+        {
+            s->ring[s->write_pos & RING_MASK] = runs[r].in[i];
+            s->write_pos++;
+
+            if (s->fade_pos < 0) wsola_check(s);
+
+            int32_t y = ring_read(s, s->delay);
+            if (s->fade_pos >= 0)
+            {
+                /* Linear crossfade, Q15 */
+                int32_t gain = (s->fade_pos * 32768) / ALGO_WSOLA_OVERLAP;
+                int32_t next = ring_read(s, s->next_delay);
+                y += ((next - y) * gain) >> 15;
+
+                s->next_delay += s->drift;
+                if (++s->fade_pos == ALGO_WSOLA_OVERLAP)
+                {
+                    s->delay = s->next_delay;
+                    s->fade_pos = -1;
+                }
+                else
+                {
+                    s->delay += s->drift;
+                }
+            }
+            else
+            {
+                s->delay += s->drift;
+            }
+
+            runs[r].out[i] = fad_sat_q15(y);
+        }
+    }
+}
+
+/* Apply the pitch ratio in params, in cents */
+static void wsola_set_ratio(algo_wsola_ctx_t *s, const struct algo_wsola_params_t *p)
+{
+    int32_t ratio = (int32_t)lroundf(exp2f(p->cents / 1200.0f) * 65536.0f);
+    if (ratio < ALGO_WSOLA_RATIO_MIN) ratio = ALGO_WSOLA_RATIO_MIN;
+    if (ratio > ALGO_WSOLA_RATIO_MAX) ratio = ALGO_WSOLA_RATIO_MAX;
+
+    s->ratio = ratio;
+    s->drift = 0x10000 - ratio;
+}
+
+void algo_wsola_init(void *ctx, fad_algo_init_params_t *params)
+{
+    algo_wsola_ctx_t *s = ctx;
+
+    memset(s->ring, 0, sizeof(s->ring));
+    s->write_pos = 0;
+    s->delay = ALGO_WSOLA_START_DELAY << 16;
+    s->next_delay = s->delay;
+    s->fade_pos = -1;
+
+    wsola_set_ratio(s, &params->algo_wsola_params);
+}
+
+void algo_wsola_update(void *ctx, fad_algo_init_params_t *params)
+{
+    /* The read delay is valid for any ratio; a new one only changes which way it drifts */
+    wsola_set_ratio(ctx, &params->algo_wsola_params);
+}
+
+void algo_wsola_deinit(void *ctx)
+{
+    // Nothing allocated
+}
@@ -0,0 +1,33 @@
+/**
+ * fad_arena.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Bump allocator over a fixed buffer. See fad_arena.h.
+ */
+
+#include <string.h>
+#include "fad_arena.h"
+
+void fad_arena_init(fad_arena_t *arena, void *buff, size_t size)
+{
+    uintptr_t start = (uintptr_t)buff;
+    uintptr_t aligned = (start + FAD_ARENA_ALIGN - 1) & ~(uintptr_t)(FAD_ARENA_ALIGN - 1);
+    size_t skip = aligned - start;
+
+    arena->base = (uint8_t *)aligned;
+    arena->size = (size > skip) ? size - skip : 0;
+    arena->used = 0;
+}
+
+void *fad_arena_alloc(fad_arena_t *arena, size_t size)
+{
+    size_t rounded = FAD_ARENA_ROUND(size);
+    if (rounded < size || rounded > arena->size - arena->used) return NULL;
+
+    void *block = arena->base + arena->used;
+    arena->used += rounded;
+    memset(block, 0, size);
+    return block;
+}
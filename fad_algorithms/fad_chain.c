@@ -0,0 +1,181 @@
+/**
+ * fad_chain.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Serial algorithm chain. Stage i writes into scratch buffer i % 2, so no stage reads and writes
+ * the same buffer and nothing is allocated or copied per block. Stage state comes from the chain's
+ * arena bank and is released all at once when the chain is cleared. While the gate is shut, the
+ * gated stages cost one pass of the detector and a memset.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include "fad_chain.h"
+
+void fad_chain_init(fad_chain_t *chain, fad_q15_t *scratch_a, fad_q15_t *scratch_b, int scratch_len, void *bank, size_t bank_size)
+{
+    fad_arena_init(&chain->arena, bank, bank_size);
+    chain->num_stages = 0;
+    chain->read_size = 0;
+    chain->scratch[0] = scratch_a;
+    chain->scratch[1] = scratch_b;
+    chain->scratch_len = scratch_len;
+    chain->num_gated = 0;
+    chain->gate_open = false;
+    fad_vad_init(&chain->vad);
+}
+
+esp_err_t fad_chain_add(fad_chain_t *chain, fad_algo_type_t type, fad_algo_mode_t mode)
+{
+    const fad_algo_desc_t *desc = fad_algo_get_desc(type);
+    if (desc == NULL) return ESP_ERR_INVALID_ARG;
+
+    /* Chain entry: add its stages instead */
+    if (desc->num_stages > 0)
+    {
+        for (int i = 0; i < desc->num_stages; i++)
+        {
+            esp_err_t err = fad_chain_add(chain, desc->stages[i], mode);
+            if (err != ESP_OK) return err;
+        }
+        return ESP_OK;
+    }
+
+    if (chain->num_stages == FAD_ALGO_MAX_STAGES) return ESP_ERR_INVALID_SIZE;
+
+    void *ctx = fad_arena_alloc(&chain->arena, desc->state_size);
+    if (ctx == NULL) return ESP_ERR_NO_MEM;
+
+    fad_algo_init_params_t params = *fad_algo_get_params(desc, mode);
+    desc->init(ctx, &params);
+
+    fad_chain_stage_t *stage = &chain->stages[chain->num_stages++];
+    stage->desc = desc;
+    stage->ctx = ctx;
+
+    if (desc->gated && chain->num_gated == chain->num_stages - 1) chain->num_gated++;
+
+    if (chain->read_size == 0 || desc->read_size < chain->read_size) chain->read_size = desc->read_size;
+
+    return ESP_OK;
+}
+
+/* Check that the stages from first onwards match type, and count them. Returns -1 on a mismatch */
+static int chain_match(const fad_chain_t *chain, int first, fad_algo_type_t type, bool *can_update)
+{
+    const fad_algo_desc_t *desc = fad_algo_get_desc(type);
+    if (desc == NULL) return -1;
+
+    if (desc->num_stages > 0)
+    {
+        int count = 0;
+        for (int i = 0; i < desc->num_stages; i++)
+        {
+            int n = chain_match(chain, first + count, desc->stages[i], can_update);
+            if (n < 0) return -1;
+            count += n;
+        }
+        return count;
+    }
+
+    if (first >= chain->num_stages || chain->stages[first].desc != desc) return -1;
+    if (desc->update == NULL) *can_update = false;
+    return 1;
+}
+
+esp_err_t fad_chain_update(fad_chain_t *chain, fad_algo_type_t type, fad_algo_mode_t mode)
+{
+    if (fad_algo_get_desc(type) == NULL) return ESP_ERR_INVALID_ARG;
+
+    /* Check every stage first so a chain is either fully retuned or left alone */
+    bool can_update = true;
+    if (chain_match(chain, 0, type, &can_update) != chain->num_stages) return ESP_ERR_INVALID_STATE;
+    if (!can_update) return ESP_ERR_NOT_SUPPORTED;
+
+    for (int i = 0; i < chain->num_stages; i++)
+    {
+        fad_algo_init_params_t params = *fad_algo_get_params(chain->stages[i].desc, mode);
+        chain->stages[i].desc->update(chain->stages[i].ctx, &params);
+    }
+
+    return ESP_OK;
+}
+
+void fad_chain_clear(fad_chain_t *chain)
+{
+    for (int i = chain->num_stages - 1; i >= 0; i--)
+    {
+        chain->stages[i].desc->deinit(chain->stages[i].ctx);
+    }
+    fad_arena_reset(&chain->arena);
+    chain->num_stages = 0;
+    chain->read_size = 0;
+    chain->num_gated = 0;
+    chain->gate_open = false;
+    fad_vad_init(&chain->vad);
+}
+
+/* Scale a block by a straight line from 0 to full (up) or full to 0, in place */
+static void chain_ramp(const fad_span_t *span, bool up)
+{
+    int len = fad_span_len(span);
+    if (len == 0) return;
+
+    int32_t step = (1 << 30) / len;     // Q30
+    int32_t gain = up ? 0 : 1 << 30;
+    if (!up) step = -step;
+    for (int s = 0; s < 2; s++)
+    {
+        fad_q15_t *x = span->seg[s];
+        for (int i = 0; i < span->len[s]; i++)
+        {
+            x[i] = (fad_q15_t)(((int32_t)x[i] * (gain >> 15)) >> 15);
+            gain += step;
+        }
+    }
+}
+
+const fad_span_t *fad_chain_run(fad_chain_t *chain, const fad_span_t *in)
+{
+    int len = fad_span_len(in);
+    if (len > chain->scratch_len) len = chain->scratch_len;
+
+    fad_span_init(&chain->scratch_span[0], chain->scratch[0], chain->scratch_len, 0, len);
+    fad_span_init(&chain->scratch_span[1], chain->scratch[1], chain->scratch_len, 0, len);
+
+    const fad_span_t *src = in;
+    int first = 0;
+    bool was_open = chain->gate_open;
+    if (chain->num_gated > 0)
+    {
+        chain->gate_open = fad_vad_update(&chain->vad, in);
+
+        if (!was_open && !chain->gate_open)
+        {
+            /* Silence from the last gated stage's buffer, without running any of them */
+            const fad_span_t *dst = &chain->scratch_span[(chain->num_gated - 1) & 1];
+            memset(dst->seg[0], 0, dst->len[0] * sizeof(fad_q15_t));
+            src = dst;
+            first = chain->num_gated;
+        }
+    }
+
+    for (int i = first; i < chain->num_stages; i++)
+    {
+        const fad_span_t *dst = &chain->scratch_span[i & 1];
+        chain->stages[i].desc->process(chain->stages[i].ctx, src, dst);
+        src = dst;
+
+        /* Fade the gated output in or out across the block where voice starts or stops */
+        if (i == chain->num_gated - 1 && was_open != chain->gate_open) chain_ramp(dst, chain->gate_open);
+    }
+
+    return src;
+}
+
+void fad_chain_process(fad_chain_t *chain, const fad_span_t *in, const fad_dac_span_t *out)
+{
+    fad_span_to_dac(fad_chain_run(chain, in), out);
+}
@@ -0,0 +1,273 @@
+/**
+ * fad_convert.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Block sample-format conversions. The word paths treat a 32-bit word as two 16-bit or four 8-bit
+ * lanes. Every lane operation is a mask, shift or xor, so lanes never carry into each other. The
+ * byte packing assumes a little-endian target (the ESP32 is).
+ */
+
+#include <stddef.h>
+#include "fad_convert.h"
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define CONVERT_WORDS 1
+#else
+#define CONVERT_WORDS 0
+#endif
+
+/* Word type that may alias the sample buffers */
+typedef uint32_t __attribute__((__may_alias__)) word_t;
+
+/* True if the pointer may be accessed as a 32-bit word */
+#define ALIGNED(p) ((((uintptr_t)(p)) & 3) == 0)
+
+void fad_convert_adc_to_q15(const uint16_t *in, fad_q15_t *out, int len)
+{
+    int i = 0;
+
+    /* Both sides hold 16-bit values, so one peeled sample aligns both if they are equally misaligned */
+    if (len > 0 && !ALIGNED(in) && !ALIGNED(out))
+    {
+        out[0] = fad_adc_to_q15(in[0]);
+        i = 1;
+    }
+
+    if (CONVERT_WORDS && ALIGNED(in + i) && ALIGNED(out + i))
+    {
+        const word_t *src = (const word_t *)(in + i);
+        word_t *dst = (word_t *)(out + i);
+        for (; i + 4 <= len; i += 4, src += 2, dst += 2)
+        {
+            dst[0] = ((src[0] & 0x0FFF0FFF) << 4) ^ 0x80008000;
+            dst[1] = ((src[1] & 0x0FFF0FFF) << 4) ^ 0x80008000;
+        }
+    }
+    for (; i < len; i++)
+    {
+        out[i] = fad_adc_to_q15(in[i]);
+    }
+}
+
+void fad_dc_block_init(fad_dc_block_t *dc)
+{
+    dc->x1 = 0;
+    dc->y1 = 0;
+}
+
+void fad_dc_block(fad_dc_block_t *dc, fad_q15_t *buff, int len)
+{
+    int32_t x1 = dc->x1, y1 = dc->y1;
+    for (int i = 0; i < len; i++)
+    {
+        int32_t x = buff[i] * (1 << FAD_DC_BLOCK_GUARD);
+        int32_t y = x - x1 + (int32_t)(((int64_t)FAD_DC_BLOCK_POLE * y1) >> 30);
+        x1 = x;
+        y1 = y;
+        buff[i] = fad_sat_q15(fad_rshift_round(y, FAD_DC_BLOCK_GUARD));
+    }
+    dc->x1 = x1;
+    dc->y1 = y1;
+}
+
+/*
+ * The DAC side moves 4 values per word. Peel samples until it is word aligned; the Q15 side is then
+ * either word aligned too, or off by one sample, in which case it is accessed 16 bits at a time.
+ */
+
+void fad_convert_q15_to_dac(const fad_q15_t *in, uint8_t *out, int len)
+{
+    int i = 0;
+    for (; i < len && !ALIGNED(out + i); i++)
+    {
+        out[i] = fad_q15_to_dac(in[i]);
+    }
+
+    if (CONVERT_WORDS)
+    {
+        word_t *dst = (word_t *)(out + i);
+        if (ALIGNED(in + i))
+        {
+            const word_t *src = (const word_t *)(in + i);
+            for (; i + 4 <= len; i += 4, src += 2, dst++)
+            {
+                /* Offset each lane to unsigned, then keep the high byte of each */
+                uint32_t a = src[0] ^ 0x80008000;
+                uint32_t b = src[1] ^ 0x80008000;
+                *dst = ((a >> 8) & 0x000000FF) | ((a >> 16) & 0x0000FF00) | ((b << 8) & 0x00FF0000) | (b & 0xFF000000);
+            }
+        }
+        else
+        {
+            for (; i + 4 <= len; i += 4, dst++)
+            {
+                *dst = fad_q15_to_dac(in[i]) | (fad_q15_to_dac(in[i + 1]) << 8) |
+                       (fad_q15_to_dac(in[i + 2]) << 16) | ((uint32_t)fad_q15_to_dac(in[i + 3]) << 24);
+            }
+        }
+    }
+    for (; i < len; i++)
+    {
+        out[i] = fad_q15_to_dac(in[i]);
+    }
+}
+
+void fad_convert_dac_to_q15(const uint8_t *in, fad_q15_t *out, int len)
+{
+    int i = 0;
+    for (; i < len && !ALIGNED(in + i); i++)
+    {
+        out[i] = fad_dac_to_q15(in[i]);
+    }
+
+    if (CONVERT_WORDS)
+    {
+        const word_t *src = (const word_t *)(in + i);
+        if (ALIGNED(out + i))
+        {
+            word_t *dst = (word_t *)(out + i);
+            for (; i + 4 <= len; i += 4, src++, dst += 2)
+            {
+                /* Offset each byte to signed, then move each into the high byte of a 16-bit lane */
+                uint32_t w = *src ^ 0x80808080;
+                dst[0] = ((w & 0x000000FF) << 8) | ((w & 0x0000FF00) << 16);
+                dst[1] = ((w >> 8) & 0x0000FF00) | (w & 0xFF000000);
+            }
+        }
+        else
+        {
+            for (; i + 4 <= len; i += 4, src++)
+            {
+                uint32_t w = *src ^ 0x80808080;
+                out[i] = (fad_q15_t)((w & 0xFF) << 8);
+                out[i + 1] = (fad_q15_t)(w & 0xFF00);
+                out[i + 2] = (fad_q15_t)((w >> 8) & 0xFF00);
+                out[i + 3] = (fad_q15_t)((w >> 16) & 0xFF00);
+            }
+        }
+    }
+    for (; i < len; i++)
+    {
+        out[i] = fad_dac_to_q15(in[i]);
+    }
+}
+
+void fad_convert_dac_to_stereo(const uint8_t *in, int16_t *out, int len, int repeat)
+{
+    int i = 0;
+    for (; i < len && !ALIGNED(in + i); i++)
+    {
+        fad_q15_t q = fad_dac_to_q15(in[i]);
+        for (int j = 0; j < repeat; j++)
+        {
+            *out++ = q;
+            *out++ = q;
+        }
+    }
+
+    /* Each frame is a whole word, so out keeps its alignment */
+    if (CONVERT_WORDS && ALIGNED(out))
+    {
+        const word_t *src = (const word_t *)(in + i);
+        word_t *dst = (word_t *)out;
+        for (; i + 4 <= len; i += 4, src++)
+        {
+            uint32_t w = *src ^ 0x80808080;
+            for (int k = 0; k < 4; k++, w >>= 8)
+            {
+                /* One frame is one word: the same sample in both 16-bit lanes */
+                uint32_t frame = ((w & 0xFF) << 8) | ((w & 0xFF) << 24);
+                for (int j = 0; j < repeat; j++) *dst++ = frame;
+            }
+        }
+        out = (int16_t *)dst;
+    }
+    for (; i < len; i++)
+    {
+        fad_q15_t q = fad_dac_to_q15(in[i]);
+        for (int j = 0; j < repeat; j++)
+        {
+            *out++ = q;
+            *out++ = q;
+        }
+    }
+}
+
+/*
+ * Packed 12-bit values are a little-endian bit stream, so 4 pairs fill exactly 3 words. Peel pairs
+ * until the packed side is word aligned (at most 3, since each pair is 3 bytes); the Q15 side is then
+ * either word aligned too, or accessed one pair at a time.
+ */
+
+/* Pack or unpack one pair with byte accesses */
+static inline void pack_pair(const fad_q15_t *in, uint8_t *out)
+{
+    uint16_t v0 = (uint16_t)in[0] >> 4;
+    uint16_t v1 = (uint16_t)in[1] >> 4;
+    out[0] = (uint8_t)v0;
+    out[1] = (uint8_t)((v0 >> 8) | (v1 << 4));
+    out[2] = (uint8_t)(v1 >> 4);
+}
+
+static inline void unpack_pair(const uint8_t *in, fad_q15_t *out)
+{
+    out[0] = (fad_q15_t)((in[0] << 4) | ((in[1] & 0x0F) << 12));
+    out[1] = (fad_q15_t)((in[1] & 0xF0) | (in[2] << 8));
+}
+
+void fad_convert_q15_to_packed12(const fad_q15_t *in, uint8_t *out, int pairs)
+{
+    int i = 0;
+    for (; i < pairs && !ALIGNED(out + 3 * i); i++)
+    {
+        pack_pair(in + 2 * i, out + 3 * i);
+    }
+
+    if (CONVERT_WORDS && ALIGNED(in + 2 * i))
+    {
+        const word_t *src = (const word_t *)(in + 2 * i);
+        word_t *dst = (word_t *)(out + 3 * i);
+        for (; i + 4 <= pairs; i += 4, src += 4, dst += 3)
+        {
+            /* Each 16-bit lane keeps its top 12 bits; 8 of them are laid end to end */
+            uint32_t a = src[0], b = src[1], c = src[2], d = src[3];
+            dst[0] = ((a >> 4) & 0x00000FFF) | ((a >> 8) & 0x00FFF000) | ((b & 0x00000FF0) << 20);
+            dst[1] = ((b >> 12) & 0x0000000F) | ((b >> 16) & 0x0000FFF0) | ((c << 12) & 0x0FFF0000) | ((c << 8) & 0xF0000000);
+            dst[2] = ((c >> 24) & 0x000000FF) | ((d << 4) & 0x000FFF00) | (d & 0xFFF00000);
+        }
+    }
+    for (; i < pairs; i++)
+    {
+        pack_pair(in + 2 * i, out + 3 * i);
+    }
+}
+
+void fad_convert_packed12_to_q15(const uint8_t *in, fad_q15_t *out, int pairs)
+{
+    int i = 0;
+    for (; i < pairs && !ALIGNED(in + 3 * i); i++)
+    {
+        unpack_pair(in + 3 * i, out + 2 * i);
+    }
+
+    if (CONVERT_WORDS && ALIGNED(out + 2 * i))
+    {
+        const word_t *src = (const word_t *)(in + 3 * i);
+        word_t *dst = (word_t *)(out + 2 * i);
+        for (; i + 4 <= pairs; i += 4, src += 3, dst += 4)
+        {
+            /* Move each 12-bit value into the top of a 16-bit lane */
+            uint32_t w0 = src[0], w1 = src[1], w2 = src[2];
+            dst[0] = ((w0 & 0x00000FFF) << 4) | ((w0 & 0x00FFF000) << 8);
+            dst[1] = ((w0 >> 20) & 0x00000FF0) | ((w1 & 0x0000000F) << 12) | ((w1 & 0x0000FFF0) << 16);
+            dst[2] = ((w1 >> 12) & 0x0000FFF0) | ((w1 >> 8) & 0x00F00000) | ((w2 & 0x000000FF) << 24);
+            dst[3] = ((w2 >> 4) & 0x0000FFF0) | (w2 & 0xFFF00000);
+        }
+    }
+    for (; i < pairs; i++)
+    {
+        unpack_pair(in + 3 * i, out + 2 * i);
+    }
+}
@@ -0,0 +1,365 @@
+/**
+ * fad_delay_line.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Delay line storage formats. 8-bit and packed 12-bit lines move whole stretches with the
+ * word-wide fad_convert.h kernels. ADPCM lines encode sample by sample as they are written, since a block may end
+ * mid-chunk, and decode a chunk at a time as they are read.
+ */
+
+#include <string.h>
+#include "fad_delay_line.h"
+#include "fad_convert.h"
+
+/* IMA-ADPCM step index adjustment per code */
+static const int8_t s_adpcm_index_table[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8,
+};
+
+/* IMA-ADPCM quantizer step sizes */
+static const int16_t s_adpcm_step_table[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+};
+
+/* Apply one code to the ADPCM state. Shared by the encoder and decoder so both track the same predictor */
+static inline void adpcm_step(int32_t *predictor, int *step_index, int code)
+{
+    int step = s_adpcm_step_table[*step_index];
+    int32_t diff = step >> 3;
+    if (code & 4) diff += step;
+    if (code & 2) diff += step >> 1;
+    if (code & 1) diff += step >> 2;
+    *predictor = fad_sat_q15(code & 8 ? *predictor - diff : *predictor + diff);
+
+    int index = *step_index + s_adpcm_index_table[code];
+    *step_index = index < 0 ? 0 : (index > 88 ? 88 : index);
+}
+
+/* Quantize the difference between a sample and the prediction to a 4-bit code */
+static inline int adpcm_encode(int32_t predictor, int step_index, fad_q15_t sample)
+{
+    int step = s_adpcm_step_table[step_index];
+    int32_t diff = sample - predictor;
+    int code = 0;
+    if (diff < 0)
+    {
+        code = 8;
+        diff = -diff;
+    }
+    if (diff >= step) { code |= 4; diff -= step; }
+    step >>= 1;
+    if (diff >= step) { code |= 2; diff -= step; }
+    step >>= 1;
+    if (diff >= step) code |= 1;
+    return code;
+}
+
+static inline uint8_t *adpcm_chunk(const fad_delay_line_t *line, int chunk)
+{
+    return line->buff + chunk * FAD_DELAY_LINE_CHUNK_BYTES;
+}
+
+/* Decode the first count samples of a chunk into its cache entry. Codes come in pairs, so an odd count decodes one extra sample that is not marked valid */
+static void adpcm_decode_chunk(fad_delay_line_t *line, fad_delay_line_cache_t *entry, int chunk, int count)
+{
+    const uint8_t *header = adpcm_chunk(line, chunk);
+    const uint8_t *codes = header + 4;
+    int32_t predictor = (int16_t)(header[0] | (header[1] << 8));
+    int step_index = header[2];
+
+    for (int i = 0; i < count; i += 2)
+    {
+        adpcm_step(&predictor, &step_index, codes[i >> 1] & 0xF);
+        entry->samples[i] = predictor;
+        adpcm_step(&predictor, &step_index, codes[i >> 1] >> 4);
+        entry->samples[i + 1] = predictor;
+    }
+
+    entry->chunk = chunk;
+    entry->valid = count;
+}
+
+/* The cache entry holding a ring position, decoding its chunk if needed */
+static const fad_delay_line_cache_t *adpcm_fetch(fad_delay_line_t *line, int pos)
+{
+    int chunk = pos / FAD_DELAY_LINE_CHUNK;
+    int index = pos % FAD_DELAY_LINE_CHUNK;
+    fad_delay_line_cache_t *entry = &line->cache[chunk & 1];
+
+    if (entry->chunk != chunk || index >= entry->valid)
+    {
+        /* The chunk being written is decoded only as far as it has been written */
+        int count = FAD_DELAY_LINE_CHUNK;
+        if (chunk == line->write_pos / FAD_DELAY_LINE_CHUNK) count = line->write_pos % FAD_DELAY_LINE_CHUNK;
+        adpcm_decode_chunk(line, entry, chunk, count);
+    }
+
+    return entry;
+}
+
+static void adpcm_write(fad_delay_line_t *line, const fad_q15_t *in, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        int chunk = line->write_pos / FAD_DELAY_LINE_CHUNK;
+        int index = line->write_pos % FAD_DELAY_LINE_CHUNK;
+        uint8_t *header = adpcm_chunk(line, chunk);
+
+        /* Starting a chunk overwrites the oldest one: record the encoder state and drop any decoded copy */
+        if (index == 0)
+        {
+            header[0] = (uint8_t)line->predictor;
+            header[1] = (uint8_t)(line->predictor >> 8);
+            header[2] = (uint8_t)line->step_index;
+            if (line->cache[chunk & 1].chunk == chunk) line->cache[chunk & 1].chunk = -1;
+        }
+
+        int code = adpcm_encode(line->predictor, line->step_index, in[i]);
+        adpcm_step(&line->predictor, &line->step_index, code);
+
+        uint8_t *byte = header + 4 + (index >> 1);
+        *byte = (index & 1) ? (uint8_t)(*byte | (code << 4)) : (uint8_t)code;
+
+        if (++line->write_pos == line->length) line->write_pos = 0;
+    }
+}
+
+static void adpcm_read(fad_delay_line_t *line, int pos, fad_q15_t *out, int len)
+{
+    while (len > 0)
+    {
+        const fad_delay_line_cache_t *entry = adpcm_fetch(line, pos);
+        int index = pos % FAD_DELAY_LINE_CHUNK;
+        int n = entry->valid - index;
+        if (n > len) n = len;
+
+        memcpy(out, entry->samples + index, n * sizeof(fad_q15_t));
+
+        out += n;
+        len -= n;
+        pos += n;
+        if (pos == line->length) pos = 0;
+    }
+}
+
+/* Pack a stretch that does not wrap. Pairs go through the block kernel; a sample sharing a pair with the stretch before or after is set alone */
+static void packed_write(uint8_t *buff, int pos, const fad_q15_t *in, int len)
+{
+    if (len > 0 && (pos & 1))
+    {
+        fad_packed12_set(buff, pos++, *in++);
+        len--;
+    }
+    fad_convert_q15_to_packed12(in, buff + 3 * (pos >> 1), len >> 1);
+    if (len & 1) fad_packed12_set(buff, pos + len - 1, in[len - 1]);
+}
+
+static void packed_read(const uint8_t *buff, int pos, fad_q15_t *out, int len)
+{
+    if (len > 0 && (pos & 1))
+    {
+        *out++ = fad_packed12_get(buff, pos++);
+        len--;
+    }
+    fad_convert_packed12_to_q15(buff + 3 * (pos >> 1), out, len >> 1);
+    if (len & 1) out[len - 1] = fad_packed12_get(buff, pos + len - 1);
+}
+
+void fad_delay_line_init(fad_delay_line_t *line, fad_delay_line_format_t format, uint8_t *buff, size_t size)
+{
+    line->format = format;
+    line->buff = buff;
+    line->write_pos = 0;
+    line->predictor = 0;
+    line->step_index = 0;
+    line->cache[0].chunk = -1;
+    line->cache[1].chunk = -1;
+
+    switch (format)
+    {
+    case FAD_DELAY_LINE_ADPCM:
+        /* All-zero chunks decode to silence */
+        line->length = (int)(size / FAD_DELAY_LINE_CHUNK_BYTES) * FAD_DELAY_LINE_CHUNK;
+        line->max_delay = line->length - FAD_DELAY_LINE_CHUNK;
+        memset(buff, 0, size);
+        break;
+    case FAD_DELAY_LINE_PACKED12:
+        /* Whole pairs only, so a pair never wraps */
+        line->length = (int)(size / 3) * 2;
+        line->max_delay = line->length;
+        memset(buff, 0, size);
+        break;
+    default:
+        line->length = (int)size;
+        line->max_delay = line->length;
+        memset(buff, fad_q15_to_dac(0), size);
+        break;
+    }
+}
+
+void fad_delay_line_write(fad_delay_line_t *line, const fad_q15_t *in, int len)
+{
+    switch (line->format)
+    {
+    case FAD_DELAY_LINE_ADPCM:
+        adpcm_write(line, in, len);
+        return;
+    case FAD_DELAY_LINE_PACKED12:
+    {
+        /* At most two stretches, split where the ring wraps */
+        int seg = line->length - line->write_pos;
+        if (seg > len) seg = len;
+        packed_write(line->buff, line->write_pos, in, seg);
+        packed_write(line->buff, 0, in + seg, len - seg);
+        break;
+    }
+    default:
+    {
+        int seg = line->length - line->write_pos;
+        if (seg > len) seg = len;
+        fad_convert_q15_to_dac(in, line->buff + line->write_pos, seg);
+        fad_convert_q15_to_dac(in + seg, line->buff, len - seg);
+        break;
+    }
+    }
+
+    line->write_pos += len;
+    if (line->write_pos >= line->length) line->write_pos -= line->length;
+}
+
+void fad_delay_line_read(fad_delay_line_t *line, int delay, fad_q15_t *out, int len)
+{
+    int pos = line->write_pos - delay;
+    if (pos < 0) pos += line->length;
+
+    switch (line->format)
+    {
+    case FAD_DELAY_LINE_ADPCM:
+        adpcm_read(line, pos, out, len);
+        break;
+    case FAD_DELAY_LINE_PACKED12:
+    {
+        int seg = line->length - pos;
+        if (seg > len) seg = len;
+        packed_read(line->buff, pos, out, seg);
+        packed_read(line->buff, 0, out + seg, len - seg);
+        break;
+    }
+    default:
+    {
+        int seg = line->length - pos;
+        if (seg > len) seg = len;
+        fad_convert_dac_to_q15(line->buff + pos, out, seg);
+        fad_convert_dac_to_q15(line->buff, out + seg, len - seg);
+        break;
+    }
+    }
+}
+
+fad_q15_t fad_delay_line_tap(fad_delay_line_t *line, int delay)
+{
+    int pos = line->write_pos - delay;
+    if (pos < 0) pos += line->length;
+
+    switch (line->format)
+    {
+    case FAD_DELAY_LINE_ADPCM:
+        return adpcm_fetch(line, pos)->samples[pos % FAD_DELAY_LINE_CHUNK];
+    case FAD_DELAY_LINE_PACKED12:
+        return fad_packed12_get(line->buff, pos);
+    default:
+        return fad_dac_to_q15(line->buff[pos]);
+    }
+}
+
+/*
+ * Interpolation. mu is the fraction of a sample, Q15, from x0 toward the older x1; xm1 is newer than x0 and x2 older than x1.
+ */
+
+static inline fad_q15_t interp_linear(int32_t x0, int32_t x1, int32_t mu)
+{
+    return (fad_q15_t)(x0 + (((x1 - x0) * mu) >> 15));
+}
+
+static inline fad_q15_t interp_lagrange(int32_t xm1, int32_t x0, int32_t x1, int32_t x2, int32_t mu)
+{
+    /* Farrow form: the polynomial through the 4 points, evaluated by Horner's rule */
+    int32_t c1 = x1 - (2 * xm1 + 3 * x0 + x2) / 6;
+    int32_t c2 = ((xm1 + x1) >> 1) - x0;
+    int32_t c3 = (x2 - xm1) / 6 + ((x0 - x1) >> 1);
+
+    int64_t y = ((int64_t)c3 * mu >> 15) + c2;
+    y = (y * mu >> 15) + c1;
+    y = (y * mu >> 15) + x0;
+    return fad_sat_q15((int32_t)y);
+}
+
+int32_t fad_delay_line_clamp(const fad_delay_line_t *line, int32_t delay)
+{
+    if (delay < (1 << 16)) return 1 << 16;
+    if (delay > (line->max_delay << 16)) return line->max_delay << 16;
+    if ((delay & 0xFFFF) == 0) return delay;
+
+    if (delay < (2 << 16)) return 2 << 16;
+    if (delay > ((line->max_delay - 2) << 16)) return (line->max_delay - 2) << 16;
+    return delay;
+}
+
+void fad_delay_line_read_frac(fad_delay_line_t *line, int32_t delay, fad_q15_t *out, int len, fad_delay_interp_t interp)
+{
+    int whole = delay >> 16;
+    int32_t mu = (delay & 0xFFFF) >> 1;
+    if (mu == 0)
+    {
+        fad_delay_line_read(line, whole, out, len);
+        return;
+    }
+
+    /* Read a window of consecutive samples, oldest first, then filter it. window[k + 1] is newer than window[k] */
+    fad_q15_t window[FAD_DELAY_LINE_CHUNK + 3];
+    while (len > 0)
+    {
+        int n = len < FAD_DELAY_LINE_CHUNK ? len : FAD_DELAY_LINE_CHUNK;
+        if (interp == FAD_DELAY_INTERP_LAGRANGE)
+        {
+            fad_delay_line_read(line, whole + 2, window, n + 3);
+            for (int i = 0; i < n; i++) out[i] = interp_lagrange(window[i + 3], window[i + 2], window[i + 1], window[i], mu);
+        }
+        else
+        {
+            fad_delay_line_read(line, whole + 1, window, n + 1);
+            for (int i = 0; i < n; i++) out[i] = interp_linear(window[i + 1], window[i], mu);
+        }
+        out += n;
+        len -= n;
+        whole -= n;
+    }
+}
+
+/* Read one sample, repeating the edge sample for delays outside the line */
+static inline int32_t tap_edge(fad_delay_line_t *line, int delay)
+{
+    if (delay < 1) delay = 1;
+    if (delay > line->max_delay) delay = line->max_delay;
+    return fad_delay_line_tap(line, delay);
+}
+
+fad_q15_t fad_delay_line_tap_frac(fad_delay_line_t *line, int32_t delay, fad_delay_interp_t interp)
+{
+    int whole = delay >> 16;
+    int32_t mu = (delay & 0xFFFF) >> 1;
+    if (mu == 0) return tap_edge(line, whole);
+
+    if (interp == FAD_DELAY_INTERP_LAGRANGE)
+    {
+        return interp_lagrange(tap_edge(line, whole - 1), tap_edge(line, whole), tap_edge(line, whole + 1), tap_edge(line, whole + 2), mu);
+    }
+    return interp_linear(tap_edge(line, whole), tap_edge(line, whole + 1), mu);
+}
@@ -0,0 +1,102 @@
+/**
+ * fad_fixed.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Fixed-point reciprocal and block kernels. See fad_fixed.h.
+ */
+
+#include "fad_fixed.h"
+
+#define RECIP_NR_ITERATIONS 3
+
+fad_q31_t fad_recip_u32(uint32_t d, int *shift)
+{
+    /* clz of 0 is undefined: take it as 1, the largest reciprocal */
+    if (d == 0) d = 1;
+
+    /* Normalize d to D in [0.5, 1) as a Q32 value: d = D * 2^(32 - n) */
+    int n = fad_clz32(d);
+    uint64_t dn = (uint64_t)(d << n);
+
+    /* Newton-Raphson on y = 1 / D, in Q30. Linear first guess 48/17 - 32/17 * D has error under 1/17,
+     * and each iteration squares the error, so three iterations are exact to Q31 precision. */
+    uint64_t y = 3031741621ULL - ((2021161081ULL * dn) >> 32);
+    for (int i = 0; i < RECIP_NR_ITERATIONS; i++)
+    {
+        uint64_t e = (dn * y) >> 32;                // D * y, Q30
+        y = (y * ((2ULL << 30) - e)) >> 30;         // y * (2 - D * y)
+    }
+
+    /* 1 / d = (1 / D) * 2^(n - 32) = y * 2^(n - 62) */
+    *shift = 62 - n;
+    return y > FAD_Q31_ONE ? FAD_Q31_ONE : (fad_q31_t)y;
+}
+
+void fad_gain_q15(const fad_q15_t *in, fad_q15_t *out, int len, fad_q15_t gain, int shift)
+{
+    /* Rounded as fad_rshift_round does, which cannot shift by 0 */
+    int rshift = 15 - shift;
+    int32_t round = rshift > 0 ? 1 << (rshift - 1) : 0;
+    for (int i = 0; i < len; i++)
+    {
+        out[i] = fad_sat_q15(((int32_t)in[i] * gain + round) >> rshift);
+    }
+}
+
+void fad_mix_q15(const fad_q15_t *a, const fad_q15_t *b, fad_q15_t *out, int len, fad_q15_t gain_a, fad_q15_t gain_b)
+{
+    for (int i = 0; i < len; i++)
+    {
+        int32_t acc = fad_mac_q15(0, a[i], gain_a);
+        acc = fad_mac_q15(acc, b[i], gain_b);
+        out[i] = fad_sat_q15(fad_rshift_round(acc, 15));
+    }
+}
+
+void fad_clip_q15(const fad_q15_t *in, fad_q15_t *out, int len, fad_q15_t lo, fad_q15_t hi)
+{
+    for (int i = 0; i < len; i++)
+    {
+        fad_q15_t x = in[i];
+        out[i] = x < lo ? lo : (x > hi ? hi : x);
+    }
+}
+
+void fad_mul_block_q15(const fad_q15_t *a, const fad_q15_t *b, fad_q15_t *out, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        out[i] = fad_mul_q15(a[i], b[i]);
+    }
+}
+
+void fad_gain_q31(const fad_q31_t *in, fad_q31_t *out, int len, fad_q31_t gain, int shift)
+{
+    int rshift = 31 - shift;
+    int64_t round = rshift > 0 ? (int64_t)1 << (rshift - 1) : 0;
+    for (int i = 0; i < len; i++)
+    {
+        out[i] = fad_sat_q31(((int64_t)in[i] * gain + round) >> rshift);
+    }
+}
+
+void fad_mix_q31(const fad_q31_t *a, const fad_q31_t *b, fad_q31_t *out, int len, fad_q31_t gain_a, fad_q31_t gain_b)
+{
+    for (int i = 0; i < len; i++)
+    {
+        int64_t acc = fad_mac_q31(0, a[i], gain_a);
+        acc = fad_mac_q31(acc, b[i], gain_b);
+        out[i] = fad_sat_q31(fad_rshift_round64(acc, 31));
+    }
+}
+
+void fad_clip_q31(const fad_q31_t *in, fad_q31_t *out, int len, fad_q31_t lo, fad_q31_t hi)
+{
+    for (int i = 0; i < len; i++)
+    {
+        fad_q31_t x = in[i];
+        out[i] = x < lo ? lo : (x > hi ? hi : x);
+    }
+}
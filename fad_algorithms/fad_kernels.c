@@ -0,0 +1,50 @@
+/**
+ * fad_kernels.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * The kernel bodies are written once as macros and instantiated for the app's block. With a constant
+ * count the compiler unrolls the loop and drops the loop-count bookkeeping; with a constant power-of-two
+ * factor the average divides with a shift. Nothing is instantiated when MULTISAMPLES is 1, since the
+ * ADC block is then converted without averaging.
+ */
+
+#include "fad_kernels.h"
+#include "fad_defs.h"
+
+#define KERNEL_UNROLL _Pragma("GCC unroll 8")
+
+/* Samples the app averages per call */
+#define BLOCK_SAMPLES (FAD_BLOCK_SIZE / MULTISAMPLES)
+
+/*
+ * Kernel bodies. N is the number of output samples, M the multisample factor.
+ */
+
+#define AVERAGE_BODY(N, M) \
+    KERNEL_UNROLL \
+    for (int i = 0; i < (N); i++) \
+    { \
+        uint32_t sum = 0; \
+        for (int j = 0; j < (M); j++) sum += in[i * (M) + j]; \
+        out[i] = sum / (M); \
+    }
+
+static void average_n(const uint16_t *in, uint16_t *out, int out_len, int factor) { AVERAGE_BODY(out_len, factor) }
+
+#if MULTISAMPLES > 1
+static void average_block(const uint16_t *in, uint16_t *out) { AVERAGE_BODY(BLOCK_SAMPLES, MULTISAMPLES) }
+#endif
+
+void fad_kernel_average(const uint16_t *in, uint16_t *out, int out_len, int factor)
+{
+#if MULTISAMPLES > 1
+    if (factor == MULTISAMPLES && out_len == BLOCK_SAMPLES)
+    {
+        average_block(in, out);
+        return;
+    }
+#endif
+    average_n(in, out, out_len, factor);
+}
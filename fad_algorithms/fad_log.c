@@ -0,0 +1,112 @@
+/**
+ * fad_log.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Deferred log ring. Any number of writers, one drain. Each slot carries a sequence number: a writer
+ * claims the next position with a compare-and-swap on the head only when that slot's sequence says it
+ * is free, fills it, and publishes it by setting the sequence to position + 1. The drain takes slots
+ * in order while they are published, and frees each by setting its sequence to the position it will
+ * next be written at. Positions are free-running 32-bit counts compared by difference, so they wrap.
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "esp_log.h"
+#include "fad_log.h"
+
+#define RING_MASK (FAD_LOG_RING_SIZE - 1)
+
+/* Longest formatted message, without the tag */
+#define LINE_LEN 128
+
+#if (FAD_LOG_RING_SIZE & RING_MASK) != 0
+#error "FAD_LOG_RING_SIZE must be a power of two"
+#endif
+
+static const char *TAG = "fad_log";
+
+static fad_log_record_t s_ring[FAD_LOG_RING_SIZE];
+static uint32_t s_head;         // Next position to claim. Shared by the writers
+static uint32_t s_tail;         // Next position to drain. Drain only
+static uint32_t s_dropped;      // Records lost to a full ring since the last drain
+
+void fad_log_init(void)
+{
+    for (uint32_t i = 0; i < FAD_LOG_RING_SIZE; i++)
+    {
+        __atomic_store_n(&s_ring[i].seq, i, __ATOMIC_RELAXED);
+    }
+    s_tail = 0;
+    __atomic_store_n(&s_dropped, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_head, 0, __ATOMIC_RELEASE);
+}
+
+void fad_log_write(uint8_t level, const char *tag, const char *format, int32_t a0, int32_t a1, int32_t a2, int32_t a3)
+{
+    uint32_t pos = __atomic_load_n(&s_head, __ATOMIC_RELAXED);
+    fad_log_record_t *rec;
+    for (;;)
+    {
+        rec = &s_ring[pos & RING_MASK];
+        int32_t diff = (int32_t)(__atomic_load_n(&rec->seq, __ATOMIC_ACQUIRE) - pos);
+        if (diff == 0)
+        {
+            /* Free: claim it. On failure pos holds the new head, so try again there */
+            if (__atomic_compare_exchange_n(&s_head, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+        }
+        else if (diff < 0)
+        {
+            /* Still holds a record from the last lap: full */
+            __atomic_fetch_add(&s_dropped, 1, __ATOMIC_RELAXED);
+            return;
+        }
+        else
+        {
+            /* Another writer took it first */
+            pos = __atomic_load_n(&s_head, __ATOMIC_RELAXED);
+        }
+    }
+
+    rec->time = esp_log_timestamp();
+    rec->tag = tag;
+    rec->format = format;
+    rec->args[0] = a0;
+    rec->args[1] = a1;
+    rec->args[2] = a2;
+    rec->args[3] = a3;
+    rec->level = level;
+    __atomic_store_n(&rec->seq, pos + 1, __ATOMIC_RELEASE);
+}
+
+int fad_log_drain(void)
+{
+    int count = 0;
+    for (;;)
+    {
+        fad_log_record_t *rec = &s_ring[s_tail & RING_MASK];
+        if (__atomic_load_n(&rec->seq, __ATOMIC_ACQUIRE) != s_tail + 1) break;
+
+        /* Copy out and free the slot before the slow part */
+        fad_log_record_t r = *rec;
+        __atomic_store_n(&rec->seq, s_tail + FAD_LOG_RING_SIZE, __ATOMIC_RELEASE);
+        s_tail++;
+
+        char line[LINE_LEN];
+        snprintf(line, sizeof(line), r.format, (int)r.args[0], (int)r.args[1], (int)r.args[2], (int)r.args[3]);
+        switch (r.level)
+        {
+        case FAD_LOG_LEVEL_ERROR: ESP_LOGE(r.tag, "[%u] %s", (unsigned)r.time, line); break;
+        case FAD_LOG_LEVEL_WARN: ESP_LOGW(r.tag, "[%u] %s", (unsigned)r.time, line); break;
+        case FAD_LOG_LEVEL_INFO: ESP_LOGI(r.tag, "[%u] %s", (unsigned)r.time, line); break;
+        default: ESP_LOGD(r.tag, "[%u] %s", (unsigned)r.time, line); break;
+        }
+        count++;
+    }
+
+    uint32_t dropped = __atomic_exchange_n(&s_dropped, 0, __ATOMIC_RELAXED);
+    if (dropped > 0) ESP_LOGW(TAG, "%u records dropped, ring full", (unsigned)dropped);
+
+    return count;
+}
@@ -0,0 +1,168 @@
+/**
+ * fad_nco.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * The oscillator's sine table and block generators. The table is const, so on the ESP32 it stays in
+ * flash (rodata) and costs no DRAM.
+ */
+
+#include "fad_nco.h"
+
+const fad_q15_t fad_nco_table[FAD_NCO_TABLE_SIZE + 1] = {
+    0, 201, 402, 603, 804, 1005, 1206, 1407, 1608, 1809, 2009, 2210,
+    2411, 2611, 2811, 3012, 3212, 3412, 3612, 3812, 4011, 4211, 4410, 4609,
+    4808, 5007, 5205, 5404, 5602, 5800, 5998, 6195, 6393, 6590, 6787, 6983,
+    7180, 7376, 7571, 7767, 7962, 8157, 8351, 8546, 8740, 8933, 9127, 9319,
+    9512, 9704, 9896, 10088, 10279, 10469, 10660, 10850, 11039, 11228, 11417, 11605,
+    11793, 11980, 12167, 12354, 12540, 12725, 12910, 13095, 13279, 13463, 13646, 13828,
+    14010, 14192, 14373, 14553, 14733, 14912, 15091, 15269, 15447, 15624, 15800, 15976,
+    16151, 16326, 16500, 16673, 16846, 17018, 17190, 17361, 17531, 17700, 17869, 18037,
+    18205, 18372, 18538, 18703, 18868, 19032, 19195, 19358, 19520, 19681, 19841, 20001,
+    20160, 20318, 20475, 20632, 20788, 20943, 21097, 21251, 21403, 21555, 21706, 21856,
+    22006, 22154, 22302, 22449, 22595, 22740, 22884, 23028, 23170, 23312, 23453, 23593,
+    23732, 23870, 24008, 24144, 24279, 24414, 24548, 24680, 24812, 24943, 25073, 25202,
+    25330, 25457, 25583, 25708, 25833, 25956, 26078, 26199, 26320, 26439, 26557, 26674,
+    26791, 26906, 27020, 27133, 27246, 27357, 27467, 27576, 27684, 27791, 27897, 28002,
+    28106, 28209, 28311, 28411, 28511, 28610, 28707, 28803, 28899, 28993, 29086, 29178,
+    29269, 29359, 29448, 29535, 29622, 29707, 29792, 29875, 29957, 30038, 30118, 30196,
+    30274, 30350, 30425, 30499, 30572, 30644, 30715, 30784, 30853, 30920, 30986, 31050,
+    31114, 31177, 31238, 31298, 31357, 31415, 31471, 31527, 31581, 31634, 31686, 31737,
+    31786, 31834, 31881, 31927, 31972, 32015, 32058, 32099, 32138, 32177, 32214, 32251,
+    32286, 32319, 32352, 32383, 32413, 32442, 32470, 32496, 32522, 32546, 32568, 32590,
+    32610, 32629, 32647, 32664, 32679, 32693, 32706, 32718, 32729, 32738, 32746, 32753,
+    32758, 32762, 32766, 32767, 32767,};
+
+/* Phase step for a frequency: freq / rate of a cycle, where a cycle is 2^32 */
+static uint32_t nco_step(int freq, int rate)
+{
+    return (uint32_t)((int64_t)freq * ((int64_t)1 << 32) / rate);
+}
+
+void fad_nco_init(fad_nco_t *nco, int freq, int rate, bool interpolate)
+{
+    nco->phase = 0;
+    nco->step = nco_step(freq, rate);
+    nco->interpolate = interpolate;
+}
+
+void fad_nco_set_freq(fad_nco_t *nco, int freq, int rate)
+{
+    nco->step = nco_step(freq, rate);
+}
+
+void fad_nco_set_period(fad_nco_t *nco, int32_t period)
+{
+    nco->step = (uint32_t)(((uint64_t)1 << 48) / (uint32_t)period);
+}
+
+void fad_nco_sin(fad_nco_t *nco, fad_q15_t *out, int len)
+{
+    uint32_t phase = nco->phase;
+    for (int i = 0; i < len; i++, phase += nco->step)
+    {
+        out[i] = fad_nco_sine(phase, nco->interpolate);
+    }
+    nco->phase = phase;
+}
+
+void fad_nco_cos(fad_nco_t *nco, fad_q15_t *out, int len)
+{
+    uint32_t phase = nco->phase;
+    for (int i = 0; i < len; i++, phase += nco->step)
+    {
+        out[i] = fad_nco_sine(phase + FAD_NCO_QUARTER, nco->interpolate);
+    }
+    nco->phase = phase;
+}
+
+void fad_nco_quad(fad_nco_t *nco, fad_q15_t *cos_out, fad_q15_t *sin_out, int len)
+{
+    uint32_t phase = nco->phase;
+    for (int i = 0; i < len; i++, phase += nco->step)
+    {
+        cos_out[i] = fad_nco_sine(phase + FAD_NCO_QUARTER, nco->interpolate);
+        sin_out[i] = fad_nco_sine(phase, nco->interpolate);
+    }
+    nco->phase = phase;
+}
+
+/*
+ * A corner is softened over the sample either side of it. x is how far a sample lies from the corner
+ * in samples, Q15 in [0, 1): the phase distance times 2^15 / step, with the reciprocal taken once per
+ * block. For a jump the correction is (1 - x)^2 of half the jump; for a change of slope it is
+ * (1 - x)^3 / 6 of the change in slope per sample.
+ */
+
+/* 2^15 / step of a cycle, so (distance * recip) >> 32 is a phase distance in samples, Q15 */
+static inline uint64_t blep_recip(uint32_t step)
+{
+    return ((uint64_t)1 << 47) / step;
+}
+
+/* Distance of phase from a corner at phase 0 in samples, Q15, or -1 if it is more than a sample away */
+static inline int32_t blep_dist(uint32_t phase, uint32_t step, uint64_t recip)
+{
+    if (phase < step) return (int32_t)(((uint64_t)phase * recip) >> 32);
+    if ((uint32_t)(0u - phase) <= step) return (int32_t)(((uint64_t)(0u - phase) * recip) >> 32);
+    return -1;
+}
+
+void fad_nco_saw(fad_nco_t *nco, fad_q15_t *out, int len)
+{
+    uint32_t phase = nco->phase;
+    const uint32_t step = nco->step;
+    const uint64_t recip = blep_recip(step);
+
+    for (int i = 0; i < len; i++, phase += step)
+    {
+        int32_t y = (int32_t)(phase >> 16) - 0x8000;
+
+        /* The jump of -2 at the wrap: lift the sample after it, lower the one before */
+        int32_t x = blep_dist(phase, step, recip);
+        if (x >= 0)
+        {
+            int32_t a = 0x8000 - x;
+            int32_t r = (a * a) >> 15;
+            y += phase < step ? r : -r;
+        }
+
+        out[i] = fad_sat_q15(y);
+    }
+    nco->phase = phase;
+}
+
+void fad_nco_triangle(fad_nco_t *nco, fad_q15_t *out, int len)
+{
+    uint32_t phase = nco->phase;
+    const uint32_t step = nco->step;
+    const uint64_t recip = blep_recip(step);
+
+    /* The slope changes by 8 cycles' worth of amplitude per cycle at each corner: 8 * step / 2^32 per
+     * sample, which over 6 is (step >> 17) * 4 / 3 in Q15 */
+    const int32_t blamp = (int32_t)((step >> 17) * 4 / 3);
+
+    for (int i = 0; i < len; i++, phase += step)
+    {
+        int32_t y = phase < 0x80000000u ? (int32_t)(phase >> 15) - 0x8000 : 0x18000 - (int32_t)(phase >> 15);
+
+        /* Round the trough at phase 0 up and the peak at half a cycle down */
+        int32_t x = blep_dist(phase, step, recip);
+        int32_t sign = 1;
+        if (x < 0)
+        {
+            x = blep_dist(phase - 0x80000000u, step, recip);
+            sign = -1;
+        }
+        if (x >= 0)
+        {
+            int32_t a = 0x8000 - x;
+            int32_t cube = (((a * a) >> 15) * a) >> 15;
+            y += sign * ((blamp * cube) >> 15);
+        }
+
+        out[i] = fad_sat_q15(y);
+    }
+    nco->phase = phase;
+}
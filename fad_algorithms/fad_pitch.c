@@ -0,0 +1,320 @@
+/**
+ * fad_pitch.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Voice pitch tracking. YIN decimates to FAD_PITCH_RATE, so everything between its Nyquist and
+ * OUTPUT_FREQ / 2 folds back into the band. A plain average leaves the upper harmonics of a high voice
+ * there, off the harmonic series, and YIN then falls an octave; a fourth-order Butterworth low-pass at
+ * FAD_PITCH_LOWPASS_HZ takes those that would land under 1 kHz down by more than 20 dB. The HPS
+ * estimator decimates by less, with an average, so its frame still holds FAD_PITCH_HPS_HARMONICS
+ * harmonics of a 500 Hz voice.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "fad_pitch.h"
+
+#define HISTORY_MASK (FAD_PITCH_HISTORY - 1)
+
+#define HPS_MASK (FAD_PITCH_HPS_FRAME - 1)
+
+#define PITCH_PI 3.14159265358979f
+#define PITCH_TWO_PI 6.28318530717959f
+
+#if (FAD_PITCH_HPS_MAX_BIN + 1) * FAD_PITCH_HPS_HARMONICS >= FAD_PITCH_HPS_FRAME / 2
+#error "The highest harmonic of FAD_PITCH_HPS_MAX_BIN must lie below Nyquist"
+#endif
+
+#if (FAD_PITCH_HISTORY & HISTORY_MASK) != 0 || FAD_PITCH_WINDOW + FAD_PITCH_MAX_LAG > FAD_PITCH_HISTORY
+#error "FAD_PITCH_HISTORY must be a power of two holding FAD_PITCH_WINDOW + FAD_PITCH_MAX_LAG samples"
+#endif
+
+/* Fraction bits of the low-pass coefficients, and the bits its samples carry below Q15 */
+#define LOWPASS_COEF_BITS 28
+#define LOWPASS_GUARD_BITS 8
+
+void fad_pitch_yin_init(fad_pitch_yin_t *yin)
+{
+    /* Butterworth, by the bilinear transform: section k has Q = 1 / (2 cos((2k + 1) pi / 2n)) for order n */
+    float k = tanf(PITCH_PI * FAD_PITCH_LOWPASS_HZ / OUTPUT_FREQ);
+    for (int s = 0; s < FAD_PITCH_LOWPASS_SECTIONS; s++)
+    {
+        float q = 0.5f / cosf(PITCH_PI * (2 * s + 1) / (4 * FAD_PITCH_LOWPASS_SECTIONS));
+        float norm = (float)(1 << LOWPASS_COEF_BITS) / (1.0f + k / q + k * k);
+        fad_pitch_biquad_t *bq = &yin->lowpass[s];
+        bq->b[0] = bq->b[2] = (int32_t)lrintf(k * k * norm);
+        bq->b[1] = 2 * bq->b[0];
+        bq->a[0] = (int32_t)lrintf(2.0f * (k * k - 1.0f) * norm);
+        bq->a[1] = (int32_t)lrintf((1.0f - k / q + k * k) * norm);
+        memset(bq->x, 0, sizeof(bq->x));
+        memset(bq->y, 0, sizeof(bq->y));
+    }
+    yin->count = 0;
+    yin->pos = 0;
+    memset(yin->history, 0, sizeof(yin->history));
+}
+
+/* Run one sample through a section, Q23 in and out */
+static inline int32_t biquad_step(fad_pitch_biquad_t *bq, int32_t x)
+{
+    int64_t acc = (int64_t)bq->b[0] * x + (int64_t)bq->b[1] * bq->x[0] + (int64_t)bq->b[2] * bq->x[1] - (int64_t)bq->a[0] * bq->y[0] - (int64_t)bq->a[1] * bq->y[1];
+    int32_t y = (int32_t)fad_rshift_round64(acc, LOWPASS_COEF_BITS);
+    bq->x[1] = bq->x[0];
+    bq->x[0] = x;
+    bq->y[1] = bq->y[0];
+    bq->y[0] = y;
+    return y;
+}
+
+void fad_pitch_yin_write(fad_pitch_yin_t *yin, const fad_q15_t *in, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        int32_t y = in[i] * (1 << LOWPASS_GUARD_BITS);
+        for (int s = 0; s < FAD_PITCH_LOWPASS_SECTIONS; s++) y = biquad_step(&yin->lowpass[s], y);
+        if (++yin->count == FAD_PITCH_DECIMATE)
+        {
+            yin->history[yin->pos] = fad_sat_q15(fad_rshift_round(y, LOWPASS_GUARD_BITS));
+            yin->pos = (yin->pos + 1) & HISTORY_MASK;
+            yin->count = 0;
+        }
+    }
+}
+
+void fad_pitch_yin_estimate(const fad_pitch_yin_t *yin, fad_pitch_t *est)
+{
+    /* The history in order, oldest first. The window ends where the longest lag reaches the newest sample */
+    fad_q15_t x[FAD_PITCH_HISTORY];
+    for (int i = 0; i < FAD_PITCH_HISTORY; i++)
+    {
+        x[i] = yin->history[(yin->pos + i) & HISTORY_MASK];
+    }
+    const fad_q15_t *w = x + FAD_PITCH_HISTORY - FAD_PITCH_WINDOW - FAD_PITCH_MAX_LAG;
+
+    /* Normalized difference of each lag, Q15: the difference over its mean across lags 1 .. tau */
+    int32_t cmnd[FAD_PITCH_MAX_LAG + 1];
+    int64_t running = 0;
+    cmnd[0] = 1 << 15;
+    for (int tau = 1; tau <= FAD_PITCH_MAX_LAG; tau++)
+    {
+        int64_t diff = 0;
+        for (int j = 0; j < FAD_PITCH_WINDOW; j++)
+        {
+            int32_t d = w[j] - w[j + tau];
+            diff += (int64_t)d * d;
+        }
+        running += diff;
+        cmnd[tau] = running > 0 ? (int32_t)((diff * tau << 15) / running) : 1 << 15;
+    }
+
+    /* The first lag under the threshold, followed down to its minimum. Failing that, the least */
+    int tau = -1;
+    for (int t = FAD_PITCH_MIN_LAG; t <= FAD_PITCH_MAX_LAG; t++)
+    {
+        if (cmnd[t] < FAD_PITCH_YIN_THRESHOLD)
+        {
+            while (t < FAD_PITCH_MAX_LAG && cmnd[t + 1] < cmnd[t]) t++;
+            tau = t;
+            break;
+        }
+    }
+    est->voiced = tau >= 0;
+    if (!est->voiced)
+    {
+        tau = FAD_PITCH_MIN_LAG;
+        for (int t = FAD_PITCH_MIN_LAG + 1; t <= FAD_PITCH_MAX_LAG; t++)
+        {
+            if (cmnd[t] < cmnd[tau]) tau = t;
+        }
+    }
+
+    /*
+     * A short period falls between whole lags, so its dip can stay over the threshold while the one at
+     * twice or three times the period does not. Take a third, then a half, of the lag if a local minimum
+     * near it is under the looser threshold: at a true period, those lags are out of phase and far above
+     */
+    for (int m = 3; m >= 2 && est->voiced; m--)
+    {
+        int best = -1;
+        for (int t = (tau + m / 2) / m - 1; t <= (tau + m / 2) / m + 1; t++)
+        {
+            if (t < FAD_PITCH_MIN_LAG || t >= FAD_PITCH_MAX_LAG) continue;
+            if (cmnd[t] <= cmnd[t - 1] && cmnd[t] <= cmnd[t + 1] && (best < 0 || cmnd[t] < cmnd[best])) best = t;
+        }
+        if (best >= 0 && cmnd[best] < FAD_PITCH_YIN_SUBMULTIPLE_THRESHOLD)
+        {
+            tau = best;
+            break;
+        }
+    }
+
+    /* Refine between lags with the parabola through the neighbours, Q16 */
+    int32_t frac = 0;
+    if (tau > 1 && tau < FAD_PITCH_MAX_LAG)
+    {
+        int32_t a = cmnd[tau - 1], b = cmnd[tau], c = cmnd[tau + 1];
+        int32_t den = a - 2 * b + c;
+        if (den > 0)
+        {
+            frac = (int32_t)((int64_t)(a - c) * (1 << 15) / den);
+            if (frac > 0x8000) frac = 0x8000;
+            if (frac < -0x8000) frac = -0x8000;
+        }
+    }
+
+    est->period = (((int32_t)tau << 16) + frac) * FAD_PITCH_DECIMATE;
+    est->confidence = fad_sat_q15((1 << 15) - cmnd[tau]);
+    if (est->confidence < 0) est->confidence = 0;
+}
+
+void fad_pitch_hps_init(fad_pitch_hps_t *hps, int interval)
+{
+    hps->acc = 0;
+    hps->count = 0;
+    hps->pos = 0;
+    hps->interval = interval > 0 ? interval : 1;
+    hps->countdown = 1;
+    memset(hps->history, 0, sizeof(hps->history));
+
+    fft_init_static(&hps->plan, FAD_PITCH_HPS_FRAME, FFT_REAL, FFT_FORWARD, hps->frame, hps->spectrum, hps->twiddles);
+    for (int i = 0; i < FAD_PITCH_HPS_FRAME; i++)
+    {
+        hps->window[i] = 0.5f - 0.5f * cosf(PITCH_TWO_PI * i / FAD_PITCH_HPS_FRAME);
+    }
+}
+
+void fad_pitch_hps_write(fad_pitch_hps_t *hps, const fad_q15_t *in, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        hps->acc += in[i];
+        if (++hps->count == FAD_PITCH_HPS_DECIMATE)
+        {
+            hps->history[hps->pos] = (fad_q15_t)(hps->acc / FAD_PITCH_HPS_DECIMATE);
+            hps->pos = (hps->pos + 1) & HPS_MASK;
+            hps->acc = 0;
+            hps->count = 0;
+        }
+    }
+}
+
+/* Power of bin k of the packed rfft spectrum, 0 < k < FAD_PITCH_HPS_FRAME / 2 */
+static inline float hps_power(const float *spectrum, int k)
+{
+    return spectrum[2 * k] * spectrum[2 * k] + spectrum[2 * k + 1] * spectrum[2 * k + 1];
+}
+
+/* Power of the strongest of bin k and its neighbours, where a harmonic near k may have landed */
+static inline float hps_power_near(const float *spectrum, int k)
+{
+    return fmaxf(hps_power(spectrum, k), fmaxf(hps_power(spectrum, k - 1), hps_power(spectrum, k + 1)));
+}
+
+bool fad_pitch_hps_estimate(fad_pitch_hps_t *hps, fad_pitch_t *est)
+{
+    if (--hps->countdown > 0) return false;
+    hps->countdown = hps->interval;
+
+    for (int i = 0; i < FAD_PITCH_HPS_FRAME; i++)
+    {
+        hps->frame[i] = hps->history[(hps->pos + i) & HPS_MASK] * hps->window[i] * (1.0f / 32768.0f);
+    }
+    fft_execute(&hps->plan);
+
+    /* The bin with the greatest product */
+    int peak = FAD_PITCH_HPS_MIN_BIN;
+    float best = -1.0f;
+    for (int k = FAD_PITCH_HPS_MIN_BIN; k <= FAD_PITCH_HPS_MAX_BIN; k++)
+    {
+        float p = hps_power(hps->spectrum, k);
+        for (int h = 2; h <= FAD_PITCH_HPS_HARMONICS; h++)
+        {
+            p *= hps_power(hps->spectrum, h * k);
+        }
+        if (p > best)
+        {
+            best = p;
+            peak = k;
+        }
+    }
+
+    /*
+     * Sub-harmonic check. In noise, the product at a half or a third of the fundamental can win: its
+     * harmonics that are not multiples of 2 (or 3) land on noise, but the rest are the voice's strongest.
+     * For a true fundamental, the harmonics that are not multiples of m hold more power than those that
+     * are, so while they hold less, the fundamental is m times the bin.
+     */
+    for (int m = 2; m <= 3; m++)
+    {
+        while (m * peak <= FAD_PITCH_HPS_MAX_BIN)
+        {
+            float off = 0.0f, on = 0.0f;
+            for (int h = 1; h <= FAD_PITCH_HPS_HARMONICS; h++)
+            {
+                if (h % m) off += hps_power_near(hps->spectrum, h * peak);
+                else on += hps_power_near(hps->spectrum, h * peak);
+            }
+            if (off >= on) break;
+            peak *= m;
+        }
+    }
+
+    /*
+     * Refine between bins. Each harmonic's peak, found within a bin of h times the fundamental's, is placed
+     * with a parabola through the log of its neighbours, and the fundamental is fitted to them all,
+     * weighted by power. Every harmonic is placed to about the same fraction of a bin, so the higher ones
+     * pin the fundamental down h times more finely than its own bin could.
+     */
+    float num = 0.0f, den = 0.0f;
+    for (int h = 1; h <= FAD_PITCH_HPS_HARMONICS; h++)
+    {
+        int k = h * peak;
+        if (hps_power(hps->spectrum, k - 1) > hps_power(hps->spectrum, k)) k--;
+        else if (hps_power(hps->spectrum, k + 1) > hps_power(hps->spectrum, k)) k++;
+
+        float pa = hps_power(hps->spectrum, k - 1), pb = hps_power(hps->spectrum, k), pc = hps_power(hps->spectrum, k + 1);
+        float offset = 0.0f;
+        if (pa > 0.0f && pb > 0.0f && pc > 0.0f)
+        {
+            float a = logf(pa), b = logf(pb), c = logf(pc);
+            float curve = a - 2.0f * b + c;
+            if (curve < 0.0f) offset = 0.5f * (a - c) / curve;
+            if (offset > 0.5f) offset = 0.5f;
+            if (offset < -0.5f) offset = -0.5f;
+        }
+        num += pb * h * (k + offset);
+        den += pb * h * h;
+    }
+    float bin = den > 0.0f ? num / den : (float)peak;
+
+    /* Period in input samples: the frame over the fundamental's bin, times the decimation */
+    float period = (float)FAD_PITCH_HPS_FRAME * FAD_PITCH_HPS_DECIMATE / bin;
+    est->period = (int32_t)lrintf(period * 65536.0f);
+
+    /*
+     * Confidence: how much more of the power lies within a bin of the harmonics than it would for
+     * white noise, which puts each bin's share there. 0 for noise, 1 when every bin off the harmonics
+     * is silent.
+     */
+    float total = 0.0f, harmonic = 0.0f;
+    int bins = 0, harmonic_bins = 0;
+    for (int k = FAD_PITCH_HPS_MIN_BIN; k <= FAD_PITCH_HPS_HARMONICS * (FAD_PITCH_HPS_MAX_BIN + 1); k++)
+    {
+        float p = hps_power(hps->spectrum, k);
+        int r = k % peak;
+        total += p;
+        bins++;
+        if (r <= 1 || r == peak - 1)
+        {
+            harmonic += p;
+            harmonic_bins++;
+        }
+    }
+    float expected = (float)harmonic_bins / bins;
+    float excess = total > 0.0f ? (harmonic / total - expected) / (1.0f - expected) : 0.0f;
+    est->confidence = excess > 0.0f ? fad_sat_q15((int32_t)lrintf(excess * 32768.0f)) : 0;
+    est->voiced = est->confidence > FAD_PITCH_HPS_MIN_CONFIDENCE;
+    return true;
+}
@@ -0,0 +1,174 @@
+/**
+ * fad_span.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Builds spans over circular buffers, splits span pairs into contiguous runs, and converts
+ * finished blocks to the DAC format.
+ */
+
+#include <stddef.h>
+#include "fad_span.h"
+#include "fad_kernels.h"
+#include "fad_convert.h"
+
+void fad_span_init(fad_span_t *span, fad_q15_t *buff, int buff_size, int pos, int len)
+{
+    int first = buff_size - pos;
+
+    span->seg[0] = buff + pos;
+    if (len <= first)
+    {
+        span->len[0] = len;
+        span->seg[1] = NULL;
+        span->len[1] = 0;
+    }
+    else
+    {
+        span->len[0] = first;
+        span->seg[1] = buff;
+        span->len[1] = len - first;
+    }
+}
+
+void fad_adc_span_init(fad_adc_span_t *span, uint16_t *buff, int buff_size, int pos, int len)
+{
+    int first = buff_size - pos;
+
+    span->seg[0] = buff + pos;
+    if (len <= first)
+    {
+        span->len[0] = len;
+        span->seg[1] = NULL;
+        span->len[1] = 0;
+    }
+    else
+    {
+        span->len[0] = first;
+        span->seg[1] = buff;
+        span->len[1] = len - first;
+    }
+}
+
+void fad_dac_span_init(fad_dac_span_t *span, uint8_t *buff, int buff_size, int pos, int len)
+{
+    int first = buff_size - pos;
+
+    span->seg[0] = buff + pos;
+    if (len <= first)
+    {
+        span->len[0] = len;
+        span->seg[1] = NULL;
+        span->len[1] = 0;
+    }
+    else
+    {
+        span->len[0] = first;
+        span->seg[1] = buff;
+        span->len[1] = len - first;
+    }
+}
+
+int fad_span_runs(const fad_span_t *in, const fad_span_t *out, fad_span_run_t runs[FAD_SPAN_MAX_RUNS])
+{
+    int in_seg = 0, out_seg = 0;    // current segment of each span
+    int in_off = 0, out_off = 0;    // offset into the current segment
+    int count = 0;
+
+    while (in_seg < 2 && out_seg < 2 && in->len[in_seg] > 0 && out->len[out_seg] > 0)
+    {
+        int in_left = in->len[in_seg] - in_off;
+        int out_left = out->len[out_seg] - out_off;
+        int len = (in_left < out_left) ? in_left : out_left;
+
+        runs[count].in = in->seg[in_seg] + in_off;
+        runs[count].out = out->seg[out_seg] + out_off;
+        runs[count].len = len;
+        count++;
+
+        in_off += len;
+        out_off += len;
+        if (in_off == in->len[in_seg])
+        {
+            in_seg++;
+            in_off = 0;
+        }
+        if (out_off == out->len[out_seg])
+        {
+            out_seg++;
+            out_off = 0;
+        }
+    }
+
+    return count;
+}
+
+void fad_span_to_dac(const fad_span_t *in, const fad_dac_span_t *out)
+{
+    int in_seg = 0, out_seg = 0;
+    int in_off = 0, out_off = 0;
+
+    while (in_seg < 2 && out_seg < 2 && in->len[in_seg] > 0 && out->len[out_seg] > 0)
+    {
+        const fad_q15_t *src = in->seg[in_seg] + in_off;
+        uint8_t *dst = out->seg[out_seg] + out_off;
+        int in_left = in->len[in_seg] - in_off;
+        int out_left = out->len[out_seg] - out_off;
+        int len = (in_left < out_left) ? in_left : out_left;
+
+        fad_convert_q15_to_dac(src, dst, len);
+
+        in_off += len;
+        out_off += len;
+        if (in_off == in->len[in_seg])
+        {
+            in_seg++;
+            in_off = 0;
+        }
+        if (out_off == out->len[out_seg])
+        {
+            out_seg++;
+            out_off = 0;
+        }
+    }
+}
+
+void fad_span_from_adc(const fad_adc_span_t *in, fad_q15_t *out, int factor)
+{
+    int len = (in->len[0] + in->len[1]) / factor;
+
+    if (factor == 1)
+    {
+        fad_convert_adc_to_q15(in->seg[0], out, in->len[0]);
+        fad_convert_adc_to_q15(in->seg[1], out + in->len[0], in->len[1]);
+        return;
+    }
+
+    /* Average into out as 12-bit values, then convert in place */
+    uint16_t *avg = (uint16_t *)out;
+
+    /* Whole groups in the first segment */
+    int groups = in->len[0] / factor;
+    fad_kernel_average(in->seg[0], avg, groups, factor);
+
+    int left = in->len[0] - groups * factor;
+    int skip = 0;   // values of the second segment already used by a split group
+    if (left > 0 && in->len[1] > 0)
+    {
+        /* A group split by the wrap */
+        uint32_t sum = 0;
+        for (int i = 0; i < left; i++) sum += in->seg[0][groups * factor + i];
+        skip = factor - left;
+        if (skip > in->len[1]) skip = in->len[1];
+        for (int i = 0; i < skip; i++) sum += in->seg[1][i];
+        avg[groups++] = sum / factor;
+    }
+
+    if (in->len[1] > skip)
+    {
+        fad_kernel_average(in->seg[1] + skip, avg + groups, (in->len[1] - skip) / factor, factor);
+    }
+
+    fad_convert_adc_to_q15(avg, out, len);
+}
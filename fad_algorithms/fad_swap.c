@@ -0,0 +1,126 @@
+/**
+ * fad_swap.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Double-buffered algorithm chains with a linear crossfade between them.
+ */
+
+#include <string.h>
+#include "fad_swap.h"
+
+void fad_swap_init(fad_swap_t *swap, fad_q15_t *scratch_a, fad_q15_t *scratch_b, fad_q15_t *fade_buff, int scratch_len, int fade_len,
+                   void *bank_a, void *bank_b, size_t bank_size)
+{
+    fad_chain_init(&swap->chains[0], scratch_a, scratch_b, scratch_len, bank_a, bank_size);
+    fad_chain_init(&swap->chains[1], scratch_a, scratch_b, scratch_len, bank_b, bank_size);
+    swap->active = 0;
+    swap->state = FAD_SWAP_IDLE;
+    swap->fade_buff = fade_buff;
+    swap->fade_len = (fade_len < 1) ? 1 : fade_len;
+    swap->fade_step = FAD_SWAP_GAIN_ONE / swap->fade_len;
+    swap->fade_gain = 0;
+}
+
+fad_chain_t *fad_swap_stage(fad_swap_t *swap)
+{
+    /* Only one fade at a time. Jump to the end of the current one */
+    if (swap->state == FAD_SWAP_FADING)
+    {
+        swap->active ^= 1;
+        swap->state = FAD_SWAP_RETIRED;
+    }
+
+    fad_swap_release(swap);
+
+    fad_chain_t *next = &swap->chains[swap->active ^ 1];
+    fad_chain_clear(next);
+    swap->state = FAD_SWAP_IDLE;
+    return next;
+}
+
+void fad_swap_commit(fad_swap_t *swap)
+{
+    swap->state = FAD_SWAP_PENDING;
+}
+
+esp_err_t fad_swap_update(fad_swap_t *swap, fad_algo_type_t type, fad_algo_mode_t mode)
+{
+    /* The chain feeding the output is ambiguous while a fade is pending or running */
+    if (swap->state == FAD_SWAP_PENDING || swap->state == FAD_SWAP_FADING) return ESP_ERR_INVALID_STATE;
+    return fad_chain_update(&swap->chains[swap->active], type, mode);
+}
+
+void fad_swap_abort(fad_swap_t *swap)
+{
+    fad_chain_clear(&swap->chains[swap->active ^ 1]);
+    swap->state = FAD_SWAP_IDLE;
+}
+
+bool fad_swap_process(fad_swap_t *swap, const fad_span_t *in, const fad_dac_span_t *out)
+{
+    fad_chain_t *active = &swap->chains[swap->active];
+
+    if (swap->state == FAD_SWAP_PENDING)
+    {
+        swap->state = FAD_SWAP_FADING;
+        swap->fade_gain = 0;
+    }
+
+    if (swap->state != FAD_SWAP_FADING)
+    {
+        fad_chain_process(active, in, out);
+        return false;
+    }
+
+    fad_chain_t *next = &swap->chains[swap->active ^ 1];
+    fad_span_run_t runs[FAD_SPAN_MAX_RUNS];
+    int num_runs;
+
+    int len = fad_span_len(in);
+    if (len > active->scratch_len) len = active->scratch_len;
+    fad_span_t fade;
+    fad_span_init(&fade, swap->fade_buff, active->scratch_len, 0, len);
+
+    /* Both chains share the scratch buffers, so keep the old output aside before running the new chain */
+    num_runs = fad_span_runs(fad_chain_run(active, in), &fade, runs);
+    for (int r = 0; r < num_runs; r++)
+    {
+        memcpy(runs[r].out, runs[r].in, runs[r].len * sizeof(fad_q15_t));
+    }
+
+    /* fade = old + (new - old) * gain, gain rising from 0 to 1 over fade_len samples */
+    int gain = swap->fade_gain;
+    num_runs = fad_span_runs(fad_chain_run(next, in), &fade, runs);
+    for (int r = 0; r < num_runs; r++)
+    {
+        const fad_q15_t *new_run = runs[r].in;
+        fad_q15_t *mix_run = runs[r].out;
+
+        for (int i = 0; i < runs[r].len; i++)
+        {
+            gain += swap->fade_step;
+            if (gain > FAD_SWAP_GAIN_ONE) gain = FAD_SWAP_GAIN_ONE;
+            int32_t old_val = mix_run[i];
+            mix_run[i] = old_val + (((new_run[i] - old_val) * gain) >> 15);
+        }
+    }
+    swap->fade_gain = gain;
+
+    fad_span_to_dac(&fade, out);
+
+    if (gain < FAD_SWAP_GAIN_ONE) return false;
+
+    swap->active ^= 1;
+    swap->state = FAD_SWAP_RETIRED;
+    return true;
+}
+
+void fad_swap_release(fad_swap_t *swap)
+{
+    if (swap->state != FAD_SWAP_RETIRED) return;
+
+    fad_chain_clear(&swap->chains[swap->active ^ 1]);
+    swap->state = FAD_SWAP_IDLE;
+}
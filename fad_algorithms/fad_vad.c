@@ -0,0 +1,70 @@
+/**
+ * fad_vad.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Voice activity detection from block energy and zero-crossing rate, with a hangover timer.
+ */
+
+#include "fad_vad.h"
+
+/* Shifts of the noise floor's rise toward a louder block, per block: about 0.7 s to follow a new
+ * background at 512-sample blocks, and 16 times that during voice */
+#define FLOOR_RISE_SHIFT 4
+#define FLOOR_RISE_SHIFT_VOICED 8
+
+void fad_vad_init(fad_vad_t *vad)
+{
+    vad->floor = FAD_VAD_MIN_FLOOR;
+    vad->energy = 0;
+    vad->zcr = 0;
+    vad->last = 0;
+    vad->hangover = 0;
+    vad->active = false;
+}
+
+bool fad_vad_update(fad_vad_t *vad, const fad_span_t *in)
+{
+    int len = fad_span_len(in);
+    if (len <= 0) return vad->active;
+
+    /* Energy and zero crossings. A crossing is a change of sign bit */
+    int64_t sum = 0;
+    int crossings = 0;
+    fad_q15_t prev = vad->last;
+    for (int s = 0; s < 2; s++)
+    {
+        const fad_q15_t *x = in->seg[s];
+        for (int i = 0; i < in->len[s]; i++)
+        {
+            sum += (int32_t)x[i] * x[i];
+            crossings += (x[i] ^ prev) < 0;
+            prev = x[i];
+        }
+    }
+    vad->last = prev;
+    vad->energy = (uint32_t)(sum / len);
+    vad->zcr = fad_sat_q15(((int32_t)crossings << 15) / len);
+
+    /* 64-bit, since the floor times the ratio can pass 32 bits */
+    uint64_t energy = vad->energy;
+    bool voiced = energy > (uint64_t)vad->floor * FAD_VAD_ONSET_RATIO &&
+                  (vad->zcr <= FAD_VAD_MAX_ZCR || energy > (uint64_t)vad->floor * FAD_VAD_LOUD_RATIO);
+
+    /* Follow a quieter background at once, a louder one slowly */
+    if (vad->energy < vad->floor)
+    {
+        vad->floor = vad->energy > FAD_VAD_MIN_FLOOR ? vad->energy : FAD_VAD_MIN_FLOOR;
+    }
+    else
+    {
+        vad->floor += (vad->energy - vad->floor) >> (voiced ? FLOOR_RISE_SHIFT_VOICED : FLOOR_RISE_SHIFT);
+    }
+
+    if (voiced) vad->hangover = FAD_VAD_HANGOVER;
+    else vad->hangover = vad->hangover > len ? vad->hangover - len : 0;
+
+    vad->active = voiced || vad->hangover > 0;
+    return vad->active;
+}
@@ -45,17 +45,14 @@
 #define USE_SPLIT_RADIX 1
 #define LARGE_BASE_CASE 1
 
-fft_config_t *fft_init(int size, fft_type_t type, fft_direction_t direction, float *input, float *output)
+fft_config_t *fft_init_static(fft_config_t *config, int size, fft_type_t type, fft_direction_t direction, float *input, float *output, float *twiddle_factors)
 {
   /*
-   * Prepare an FFT of correct size and types.
-   *
-   * If no input or output buffers are provided, they will be allocated.
+   * Prepare an FFT of correct size and types in caller-provided memory. Nothing is allocated,
+   * so the config must not be passed to fft_destroy.
    */
   int k,m;
 
-  fft_config_t *config = (fft_config_t *)malloc(sizeof(fft_config_t));
-
   // Check if the size is a power of two
   if ((size & (size-1)) != 0)  // tests if size is a power of two
     return NULL;
@@ -65,9 +62,11 @@ fft_config_t *fft_init(int size, fft_type_t type, fft_direction_t direction, flo
   config->type = type;
   config->direction = direction;
   config->size = size;
+  config->input = input;
+  config->output = output;
 
-  // Allocate and precompute twiddle factors
-  config->twiddle_factors = (float *)malloc(2 * config->size * sizeof(float));
+  // Precompute twiddle factors
+  config->twiddle_factors = twiddle_factors;
 
   float two_pi_by_n = TWO_PI / config->size;
 
@@ -77,6 +76,34 @@ fft_config_t *fft_init(int size, fft_type_t type, fft_direction_t direction, flo
     config->twiddle_factors[m+1] = sinf(two_pi_by_n * k);  // imag
   }
 
+  return config;
+}
+
+fft_config_t *fft_init(int size, fft_type_t type, fft_direction_t direction, float *input, float *output)
+{
+  /*
+   * Prepare an FFT of correct size and types.
+   *
+   * If no input or output buffers are provided, they will be allocated.
+   */
+  // Check if the size is a power of two
+  if ((size & (size-1)) != 0)  // tests if size is a power of two
+    return NULL;
+
+  fft_config_t *config = (fft_config_t *)malloc(sizeof(fft_config_t));
+  if (config == NULL)
+    return NULL;
+
+  // Allocate and precompute twiddle factors
+  float *twiddle_factors = (float *)malloc(2 * size * sizeof(float));
+  if (twiddle_factors == NULL)
+  {
+    free(config);
+    return NULL;
+  }
+
+  fft_init_static(config, size, type, direction, input, output, twiddle_factors);
+
   // Allocate input buffer
   if (input != NULL)
     config->input = input;
@@ -91,7 +118,10 @@ fft_config_t *fft_init(int size, fft_type_t type, fft_direction_t direction, flo
   }
 
   if (config->input == NULL)
+  {
+    fft_destroy(config);
     return NULL;
+  }
 
   // Allocate output buffer
   if (output != NULL)
@@ -107,7 +137,10 @@ fft_config_t *fft_init(int size, fft_type_t type, fft_direction_t direction, flo
   }
 
   if (config->output == NULL)
+  {
+    fft_destroy(config);
     return NULL;
+  }
 
   return config;
 }
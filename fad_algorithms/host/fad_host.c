@@ -0,0 +1,59 @@
+/**
+ * fad_host.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Host implementations of the few ESP-IDF functions the algorithms call.
+ */
+
+#include <time.h>
+#include "esp_system.h"
+#include "esp_err.h"
+#include "esp_log.h"
+
+esp_log_level_t fad_host_log_level = ESP_LOG_WARN;
+
+uint32_t esp_log_timestamp(void)
+{
+    static struct timespec start;
+    struct timespec now;
+    if (start.tv_sec == 0 && start.tv_nsec == 0) clock_gettime(CLOCK_MONOTONIC, &start);
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000);
+}
+
+static uint32_t s_random_state = 0x2545F491;
+
+uint32_t esp_random(void)
+{
+    /* xorshift32 */
+    uint32_t x = s_random_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s_random_state = x;
+    return x;
+}
+
+void fad_host_seed_random(uint32_t seed)
+{
+    s_random_state = seed ? seed : 0x2545F491;
+}
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code)
+    {
+    case ESP_OK: return "ESP_OK";
+    case ESP_FAIL: return "ESP_FAIL";
+    case ESP_ERR_NO_MEM: return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG: return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_INVALID_SIZE: return "ESP_ERR_INVALID_SIZE";
+    case ESP_ERR_NOT_FOUND: return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_NOT_SUPPORTED: return "ESP_ERR_NOT_SUPPORTED";
+    case ESP_ERR_TIMEOUT: return "ESP_ERR_TIMEOUT";
+    default: return "UNKNOWN ERROR";
+    }
+}
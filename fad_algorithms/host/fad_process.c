@@ -0,0 +1,196 @@
+/**
+ * fad_process.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Offline processing tool. Streams a WAV file through an algorithm from the registry, block by
+ * block exactly as the device does (ADC format in, Q15 through the chain, optionally quantized to
+ * the DAC), writes the result as a WAV file, and reports how long the algorithm took.
+ *
+ * The input should be sampled at OUTPUT_FREQ to hear what the device would produce; other rates
+ * are processed as-is.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <time.h>
+
+#include "esp_system.h"
+#include "esp_log.h"
+#include "fad_defs.h"
+#include "fad_chain.h"
+#include "fad_convert.h"
+#include "fad_wav.h"
+#include "fad_log.h"
+
+static const char *TAG = "fad_process";
+
+static fad_q15_t s_scratch[2][DAC_BUFFER_SIZE];
+static uint8_t s_bank[FAD_ALGO_BANK_SIZE] __attribute__((aligned(FAD_ARENA_ALIGN)));
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [options] <in.wav> <out.wav>\n"
+            "  -a <algo>   algorithm number, see -l (default 0)\n"
+            "  -m <mode>   algorithm mode, 1 to %d (default 1)\n"
+            "  -b <size>   output samples per block (default: the algorithm's read size)\n"
+            "  -d          quantize the output to 8 bits, like the DAC\n"
+            "  -s <seed>   seed for esp_random\n"
+            "  -v          print algorithm log messages (repeat for debug)\n"
+            "  -l          list the algorithms and exit\n",
+            prog, FAD_ALGO_MODE_COUNT);
+}
+
+static void list_algorithms(void)
+{
+    for (int i = 0; i < FAD_ALGO_COUNT; i++)
+    {
+        const fad_algo_desc_t *desc = fad_algo_get_desc(i);
+        printf("%2d  %-28s read size %4d%s\n", i, desc->name, desc->read_size, desc->num_stages > 0 ? "  (chain)" : "");
+    }
+}
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+int main(int argc, char **argv)
+{
+    int algo = 0;
+    int mode = 1;
+    int block = 0;
+    bool dac = false;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "a:m:b:ds:vlh")) != -1)
+    {
+        switch (opt)
+        {
+        case 'a': algo = atoi(optarg); break;
+        case 'm': mode = atoi(optarg); break;
+        case 'b': block = atoi(optarg); break;
+        case 'd': dac = true; break;
+        case 's': fad_host_seed_random(strtoul(optarg, NULL, 0)); break;
+        case 'v': fad_host_log_level = (fad_host_log_level < ESP_LOG_INFO) ? ESP_LOG_INFO : ESP_LOG_DEBUG; break;
+        case 'l': list_algorithms(); return 0;
+        default: usage(argv[0]); return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    if (argc - optind != 2)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+    if (algo < 0 || algo >= FAD_ALGO_COUNT || mode < 1 || mode > FAD_ALGO_MODE_COUNT)
+    {
+        ESP_LOGE(TAG, "No algorithm %d mode %d. Use -l to list the algorithms", algo, mode);
+        return 1;
+    }
+
+    /* Build the chain the same way the app does */
+    fad_chain_t chain;
+    fad_log_init();
+    fad_chain_init(&chain, s_scratch[0], s_scratch[1], DAC_BUFFER_SIZE, s_bank, sizeof(s_bank));
+    esp_err_t err = fad_chain_add(&chain, algo, mode - 1);
+    if (err != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Could not set up %s: %s", fad_algo_get_desc(algo)->name, esp_err_to_name(err));
+        return 1;
+    }
+
+    if (block <= 0) block = chain.read_size / MULTISAMPLES;
+    if (block > DAC_BUFFER_SIZE) block = DAC_BUFFER_SIZE;
+
+    fad_wav_t in_wav, out_wav;
+    err = fad_wav_open_read(&in_wav, argv[optind]);
+    if (err != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Could not read %s: %s", argv[optind], esp_err_to_name(err));
+        return 1;
+    }
+    if (in_wav.rate != OUTPUT_FREQ)
+    {
+        ESP_LOGW(TAG, "%s is sampled at %d Hz; the device runs at %d Hz. Processing without resampling",
+                 argv[optind], in_wav.rate, OUTPUT_FREQ);
+    }
+    if (fad_wav_open_write(&out_wav, argv[optind + 1], in_wav.rate) != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Could not create %s", argv[optind + 1]);
+        fad_wav_close(&in_wav, false);
+        return 1;
+    }
+
+    static int16_t pcm[DAC_BUFFER_SIZE];
+    static uint16_t adc[DAC_BUFFER_SIZE];
+    static fad_q15_t input[DAC_BUFFER_SIZE];
+    static uint8_t dac_vals[DAC_BUFFER_SIZE];
+
+    fad_dc_block_t input_dc;
+    fad_dc_block_init(&input_dc);
+
+    long blocks = 0, samples = 0;
+    double total_us = 0, max_us = 0;
+    int len;
+
+    while ((len = fad_wav_read(&in_wav, pcm, block)) > 0)
+    {
+        /* 16-bit PCM to the ADC format, then into the chain like an ADC block */
+        for (int i = 0; i < len; i++) adc[i] = ((uint16_t)pcm[i] ^ 0x8000) >> 4;
+        fad_convert_adc_to_q15(adc, input, len);
+        fad_dc_block(&input_dc, input, len);
+
+        fad_span_t in_span;
+        fad_span_init(&in_span, input, DAC_BUFFER_SIZE, 0, len);
+
+        double start = now_us();
+        const fad_span_t *out_span = fad_chain_run(&chain, &in_span);
+        double elapsed = now_us() - start;
+
+        total_us += elapsed;
+        if (elapsed > max_us) max_us = elapsed;
+        blocks++;
+        samples += len;
+
+        /* Chain output is contiguous: scratch spans never wrap, and an empty chain returns in_span */
+        const fad_q15_t *result = out_span->seg[0];
+        if (dac)
+        {
+            fad_convert_q15_to_dac(result, dac_vals, len);
+            fad_convert_dac_to_q15(dac_vals, pcm, len);
+            result = pcm;
+        }
+
+        /* Print the block's log records outside the timed part, as the drain task would */
+        fad_log_drain();
+
+        if (fad_wav_write(&out_wav, result, len) != ESP_OK)
+        {
+            ESP_LOGE(TAG, "Could not write %s", argv[optind + 1]);
+            break;
+        }
+    }
+
+    fad_chain_clear(&chain);
+    fad_log_drain();
+    fad_wav_close(&in_wav, false);
+    if (fad_wav_close(&out_wav, true) != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Could not finish %s", argv[optind + 1]);
+        return 1;
+    }
+
+    /* Profile. Speed is the duration of the audio at OUTPUT_FREQ over the processing time */
+    double audio_us = samples * 1e6 / OUTPUT_FREQ;
+    printf("%s, mode %d: %ld blocks of %d samples\n", fad_algo_get_desc(algo)->name, mode, blocks, block);
+    printf("  %.2f us per block average, %.2f us max, %.0fx real time on this host\n",
+           blocks ? total_us / blocks : 0.0, max_us, total_us > 0 ? audio_us / total_us : 0.0);
+    return 0;
+}
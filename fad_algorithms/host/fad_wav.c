@@ -0,0 +1,183 @@
+/**
+ * fad_wav.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Minimal streaming WAV reader and writer. Multi-byte fields are assembled byte by byte, so the
+ * files are little-endian regardless of the host.
+ */
+
+#include <string.h>
+#include "fad_wav.h"
+
+#define WAV_HEADER_SIZE 44
+#define WAV_FORMAT_PCM 1
+#define WAV_READ_CHUNK 256  // frames converted per fread
+
+static uint32_t get_u32(const uint8_t *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+static uint16_t get_u16(const uint8_t *p) { return p[0] | (p[1] << 8); }
+static void put_u32(uint8_t *p, uint32_t v) { p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24; }
+static void put_u16(uint8_t *p, uint16_t v) { p[0] = v; p[1] = v >> 8; }
+
+esp_err_t fad_wav_open_read(fad_wav_t *wav, const char *path)
+{
+    uint8_t hdr[16];
+    bool have_fmt = false;
+
+    wav->file = fopen(path, "rb");
+    if (wav->file == NULL) return ESP_ERR_NOT_FOUND;
+
+    if (fread(hdr, 1, 12, wav->file) != 12 || memcmp(hdr, "RIFF", 4) != 0 || memcmp(hdr + 8, "WAVE", 4) != 0)
+    {
+        fclose(wav->file);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Walk the chunks until the data chunk, reading fmt on the way */
+    while (fread(hdr, 1, 8, wav->file) == 8)
+    {
+        uint32_t size = get_u32(hdr + 4);
+
+        if (memcmp(hdr, "fmt ", 4) == 0 && size >= 16)
+        {
+            if (fread(hdr, 1, 16, wav->file) != 16) break;
+            if (get_u16(hdr) != WAV_FORMAT_PCM)
+            {
+                fclose(wav->file);
+                return ESP_ERR_NOT_SUPPORTED;
+            }
+            wav->channels = get_u16(hdr + 2);
+            wav->rate = get_u32(hdr + 4);
+            wav->bits = get_u16(hdr + 14);
+            have_fmt = true;
+            size -= 16;
+        }
+        else if (memcmp(hdr, "data", 4) == 0)
+        {
+            if (!have_fmt) break;
+            if ((wav->bits != 8 && wav->bits != 16) || wav->channels < 1)
+            {
+                fclose(wav->file);
+                return ESP_ERR_NOT_SUPPORTED;
+            }
+            wav->frames = size / (wav->channels * (wav->bits / 8));
+            return ESP_OK;
+        }
+
+        /* Chunks are padded to an even size */
+        if (fseek(wav->file, size + (size & 1), SEEK_CUR) != 0) break;
+    }
+
+    fclose(wav->file);
+    return ESP_ERR_INVALID_ARG;
+}
+
+int fad_wav_read(fad_wav_t *wav, int16_t *out, int frames)
+{
+    uint8_t raw[WAV_READ_CHUNK * 2 * 8];    // WAV_READ_CHUNK frames of up to 8 channels; fewer frames for more channels
+    int bytes_per_frame = wav->channels * (wav->bits / 8);
+    int chunk_frames = sizeof(raw) / bytes_per_frame;
+    int total = 0;
+
+    if (chunk_frames > WAV_READ_CHUNK) chunk_frames = WAV_READ_CHUNK;
+    if (chunk_frames < 1) return 0;
+    if (frames > wav->frames) frames = wav->frames;
+
+    while (total < frames)
+    {
+        int want = frames - total;
+        if (want > chunk_frames) want = chunk_frames;
+
+        int got = fread(raw, bytes_per_frame, want, wav->file);
+        for (int i = 0; i < got; i++)
+        {
+            int32_t sum = 0;
+            for (int c = 0; c < wav->channels; c++)
+            {
+                if (wav->bits == 16)
+                    sum += (int16_t)get_u16(&raw[(i * wav->channels + c) * 2]);
+                else
+                    sum += (raw[i * wav->channels + c] - 128) << 8;
+            }
+            out[total + i] = sum / wav->channels;
+        }
+
+        total += got;
+        if (got < want) break;
+    }
+
+    wav->frames -= total;
+    return total;
+}
+
+esp_err_t fad_wav_open_write(fad_wav_t *wav, const char *path, int rate)
+{
+    uint8_t hdr[WAV_HEADER_SIZE] = {0};
+
+    wav->file = fopen(path, "wb");
+    if (wav->file == NULL) return ESP_FAIL;
+
+    wav->channels = 1;
+    wav->bits = 16;
+    wav->rate = rate;
+    wav->frames = 0;
+
+    /* Sizes are filled in by fad_wav_close */
+    memcpy(hdr, "RIFF", 4);
+    memcpy(hdr + 8, "WAVEfmt ", 8);
+    put_u32(hdr + 16, 16);
+    put_u16(hdr + 20, WAV_FORMAT_PCM);
+    put_u16(hdr + 22, 1);
+    put_u32(hdr + 24, rate);
+    put_u32(hdr + 28, rate * 2);
+    put_u16(hdr + 32, 2);
+    put_u16(hdr + 34, 16);
+    memcpy(hdr + 36, "data", 4);
+
+    if (fwrite(hdr, 1, WAV_HEADER_SIZE, wav->file) != WAV_HEADER_SIZE)
+    {
+        fclose(wav->file);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+esp_err_t fad_wav_write(fad_wav_t *wav, const int16_t *in, int frames)
+{
+    uint8_t raw[WAV_READ_CHUNK * 2];
+
+    for (int done = 0; done < frames; )
+    {
+        int n = frames - done;
+        if (n > WAV_READ_CHUNK) n = WAV_READ_CHUNK;
+
+        for (int i = 0; i < n; i++) put_u16(&raw[i * 2], (uint16_t)in[done + i]);
+        if (fwrite(raw, 2, n, wav->file) != (size_t)n) return ESP_FAIL;
+
+        done += n;
+    }
+
+    wav->frames += frames;
+    return ESP_OK;
+}
+
+esp_err_t fad_wav_close(fad_wav_t *wav, bool writing)
+{
+    esp_err_t err = ESP_OK;
+
+    if (writing)
+    {
+        uint8_t field[4];
+        uint32_t data_size = wav->frames * 2;
+
+        put_u32(field, WAV_HEADER_SIZE - 8 + data_size);
+        if (fseek(wav->file, 4, SEEK_SET) != 0 || fwrite(field, 1, 4, wav->file) != 4) err = ESP_FAIL;
+
+        put_u32(field, data_size);
+        if (fseek(wav->file, 40, SEEK_SET) != 0 || fwrite(field, 1, 4, wav->file) != 4) err = ESP_FAIL;
+    }
+
+    if (fclose(wav->file) != 0) err = ESP_FAIL;
+    return err;
+}
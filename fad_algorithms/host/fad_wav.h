@@ -0,0 +1,76 @@
+/**
+ * fad_wav.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Minimal streaming WAV reader and writer for the host tools. Reads 8 or 16-bit PCM with any
+ * number of channels, mixed down to mono 16-bit. Writes mono 16-bit PCM.
+ */
+
+#ifndef _FAD_WAV_H_
+#define _FAD_WAV_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+typedef struct {
+    FILE *file;
+    int channels;       // Channels in the file
+    int bits;           // Bits per sample in the file
+    int rate;           // Frames per second
+    long frames;        // Reading: frames left in the data chunk. Writing: frames written
+} fad_wav_t;
+
+/**
+ * @brief Open a WAV file and position it at the first sample
+ * @param wav [OUT] The reader
+ * @param path The file
+ * @return
+ *      -ESP_OK if successful
+ *      -ESP_ERR_NOT_FOUND if the file cannot be opened
+ *      -ESP_ERR_INVALID_ARG if the file is not a WAV file
+ *      -ESP_ERR_NOT_SUPPORTED if the file is not 8 or 16-bit PCM
+ */
+esp_err_t fad_wav_open_read(fad_wav_t *wav, const char *path);
+
+/**
+ * @brief Read frames, mixed down to mono
+ * @param wav The reader
+ * @param out [OUT] The samples
+ * @param frames Most frames to read
+ * @return Number of frames read. 0 at the end of the data
+ */
+int fad_wav_read(fad_wav_t *wav, int16_t *out, int frames);
+
+/**
+ * @brief Create a mono 16-bit WAV file. The header is completed by fad_wav_close.
+ * @param wav [OUT] The writer
+ * @param path The file
+ * @param rate Frames per second
+ * @return
+ *      -ESP_OK if successful
+ *      -ESP_FAIL if the file cannot be created
+ */
+esp_err_t fad_wav_open_write(fad_wav_t *wav, const char *path, int rate);
+
+/**
+ * @brief Append frames
+ * @param wav The writer
+ * @param in The samples
+ * @param frames Number of frames
+ * @return ESP_OK, or ESP_FAIL if the write failed
+ */
+esp_err_t fad_wav_write(fad_wav_t *wav, const int16_t *in, int frames);
+
+/**
+ * @brief Close a reader or writer. Writers get their header sizes filled in.
+ * @param wav The reader or writer
+ * @param writing true for a writer
+ * @return ESP_OK, or ESP_FAIL if the header could not be written
+ */
+esp_err_t fad_wav_close(fad_wav_t *wav, bool writing);
+
+#endif
@@ -0,0 +1,16 @@
+/**
+ * adc.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Host stand-in for the ESP-IDF driver header of the same name. The algorithms include it but
+ * use nothing from it; there is no ADC on the host.
+ */
+
+#ifndef _DRIVER_ADC_H_
+#define _DRIVER_ADC_H_
+
+#include "esp_err.h"
+
+#endif
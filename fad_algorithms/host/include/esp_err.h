@@ -0,0 +1,33 @@
+/**
+ * esp_err.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Host stand-in for the ESP-IDF header of the same name. Only what fad_algorithms uses, with the
+ * same values as ESP-IDF so error codes read the same on both targets.
+ */
+
+#ifndef _ESP_ERR_H_
+#define _ESP_ERR_H_
+
+#include <stdint.h>
+
+typedef int esp_err_t;
+
+#define ESP_OK                  0
+#define ESP_FAIL                -1
+#define ESP_ERR_NO_MEM          0x101
+#define ESP_ERR_INVALID_ARG     0x102
+#define ESP_ERR_INVALID_STATE   0x103
+#define ESP_ERR_INVALID_SIZE    0x104
+#define ESP_ERR_NOT_FOUND       0x105
+#define ESP_ERR_NOT_SUPPORTED   0x106
+#define ESP_ERR_TIMEOUT         0x107
+
+/**
+ * @brief Name of an error code, for messages
+ */
+const char *esp_err_to_name(esp_err_t code);
+
+#endif
@@ -0,0 +1,43 @@
+/**
+ * esp_log.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Host stand-in for the ESP-IDF header of the same name. Messages go to stderr, filtered by
+ * fad_host_log_level so per-block logging does not drown offline runs.
+ */
+
+#ifndef _ESP_LOG_H_
+#define _ESP_LOG_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+typedef enum {
+    ESP_LOG_NONE,
+    ESP_LOG_ERROR,
+    ESP_LOG_WARN,
+    ESP_LOG_INFO,
+    ESP_LOG_DEBUG,
+    ESP_LOG_VERBOSE,
+} esp_log_level_t;
+
+/* Milliseconds since the first call */
+uint32_t esp_log_timestamp(void);
+
+/* Most detailed level printed. ESP_LOG_WARN unless the host program changes it */
+extern esp_log_level_t fad_host_log_level;
+
+#define FAD_HOST_LOG(level, letter, tag, format, ...) \
+    do { \
+        if (fad_host_log_level >= (level)) fprintf(stderr, letter " (%s) " format "\n", tag, ##__VA_ARGS__); \
+    } while (0)
+
+#define ESP_LOGE(tag, format, ...) FAD_HOST_LOG(ESP_LOG_ERROR, "E", tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) FAD_HOST_LOG(ESP_LOG_WARN, "W", tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) FAD_HOST_LOG(ESP_LOG_INFO, "I", tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) FAD_HOST_LOG(ESP_LOG_DEBUG, "D", tag, format, ##__VA_ARGS__)
+#define ESP_LOGV(tag, format, ...) FAD_HOST_LOG(ESP_LOG_VERBOSE, "V", tag, format, ##__VA_ARGS__)
+
+#endif
@@ -0,0 +1,33 @@
+/**
+ * esp_system.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Host stand-in for the ESP-IDF header of the same name. Only what fad_algorithms uses.
+ */
+
+#ifndef _ESP_SYSTEM_H_
+#define _ESP_SYSTEM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+/* Code placement attributes have no meaning on the host */
+#define IRAM_ATTR
+#define DRAM_ATTR
+
+/**
+ * @brief Pseudo-random 32-bit value. Deterministic on the host, see fad_host_seed_random
+ */
+uint32_t esp_random(void);
+
+/**
+ * @brief Host only: restart the esp_random sequence, so runs can be reproduced
+ * @param seed Any value
+ */
+void fad_host_seed_random(uint32_t seed);
+
+#endif
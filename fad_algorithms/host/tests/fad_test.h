@@ -0,0 +1,80 @@
+/**
+ * fad_test.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Helpers shared by the host regression tests. Each test is its own executable, registered with ctest
+ * in CMakeLists.txt: it runs its checks, prints every failure, and exits non-zero if any failed.
+ * Signals come from esp_random, which is deterministic on the host, so every run sees the same input.
+ */
+
+#ifndef _FAD_TEST_H_
+#define _FAD_TEST_H_
+
+#include <math.h>
+#include <stdio.h>
+#include "esp_system.h"
+#include "fad_fixed.h"
+
+#define FAD_TEST_PI 3.14159265358979
+
+static int fad_test_failures = 0;
+
+/* Record a failure if cond is false. The remaining arguments are a printf message */
+#define FAD_CHECK(cond, ...) \
+    do { \
+        if (!(cond)) \
+        { \
+            fprintf(stderr, "%s:%d: check failed: %s: ", __FILE__, __LINE__, #cond); \
+            fprintf(stderr, __VA_ARGS__); \
+            fputc('\n', stderr); \
+            fad_test_failures++; \
+        } \
+    } while (0)
+
+/* Exit status for main */
+static inline int fad_test_result(const char *name)
+{
+    if (fad_test_failures) fprintf(stderr, "%s: %d checks failed\n", name, fad_test_failures);
+    else printf("%s: passed\n", name);
+    return fad_test_failures ? 1 : 0;
+}
+
+/* Amplitude of the component of x at freq (Goertzel), in the units of x */
+static inline double fad_test_amplitude(const fad_q15_t *x, int len, double freq, int rate)
+{
+    double w = 2.0 * FAD_TEST_PI * freq / rate;
+    double c = 0.0, s = 0.0;
+    for (int i = 0; i < len; i++)
+    {
+        c += x[i] * cos(w * i);
+        s += x[i] * sin(w * i);
+    }
+    return 2.0 * sqrt(c * c + s * s) / len;
+}
+
+/* Uniform noise in [-amp, amp] */
+static inline fad_q15_t fad_test_noise(int amp)
+{
+    return (fad_q15_t)((int32_t)(esp_random() % (2 * amp + 1)) - amp);
+}
+
+/*
+ * A harmonic tone: harmonics 1 .. harmonics of f0 with amplitudes falling as 1 / k, the sum peaking
+ * near amp, plus uniform noise of noise_amp. Like a voiced vowel without formants.
+ */
+static inline void fad_test_harmonic_tone(fad_q15_t *out, int len, double f0, int harmonics, double amp, int noise_amp, int rate)
+{
+    double norm = 0.0;
+    for (int k = 1; k <= harmonics; k++) norm += 1.0 / k;
+    for (int i = 0; i < len; i++)
+    {
+        double v = 0.0;
+        for (int k = 1; k <= harmonics; k++) v += sin(2.0 * FAD_TEST_PI * f0 * k * i / rate) / k;
+        int32_t q = (int32_t)lrint(v * amp * 32767.0 / norm) + (noise_amp ? fad_test_noise(noise_amp) : 0);
+        out[i] = fad_sat_q15(q);
+    }
+}
+
+#endif
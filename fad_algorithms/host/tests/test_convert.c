@@ -0,0 +1,152 @@
+/**
+ * test_convert.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Sample-format conversions. The scalar conversions are checked exhaustively against the formats'
+ * definitions, and the block kernels against the scalar conversions at every alignment of their
+ * buffers, so the word paths and the samples peeled around them are all covered. Also checks that
+ * the shared DC blocker removes a bias and passes speech frequencies.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "fad_convert.h"
+#include "fad_defs.h"
+#include "fad_test.h"
+
+/* Longest block tried at each alignment: several words, plus every possible tail */
+#define MAX_LEN 41
+
+static void test_scalar(void)
+{
+    /* ADC -> Q15 -> DAC keeps the top 8 bits of every ADC value, and midscale is 0 */
+    for (int adc = 0; adc < 4096; adc++)
+    {
+        fad_q15_t q = fad_adc_to_q15((uint16_t)adc);
+        FAD_CHECK(q == (adc - FAD_ADC_MIDSCALE) * 16, "adc %d -> q15 %d", adc, q);
+        FAD_CHECK(fad_q15_to_dac(q) == adc >> 4, "adc %d -> dac %d", adc, fad_q15_to_dac(q));
+    }
+
+    /* DAC -> Q15 -> DAC is the identity */
+    for (int dac = 0; dac < 256; dac++)
+    {
+        FAD_CHECK(fad_q15_to_dac(fad_dac_to_q15((uint8_t)dac)) == dac, "dac %d", dac);
+    }
+
+    /* Packed 12-bit keeps every ADC value, and a sample written next to another leaves it alone */
+    uint8_t packed[3] = { 0 };
+    for (int adc = 0; adc < 4096; adc++)
+    {
+        fad_q15_t q = fad_adc_to_q15((uint16_t)adc);
+        fad_q15_t other = fad_adc_to_q15((uint16_t)(4095 - adc));
+        for (int pos = 0; pos < 2; pos++)
+        {
+            fad_packed12_set(packed, pos ^ 1, other);
+            fad_packed12_set(packed, pos, q);
+            FAD_CHECK(fad_packed12_get(packed, pos) == q, "adc %d at %d", adc, pos);
+            FAD_CHECK(fad_packed12_get(packed, pos ^ 1) == other, "neighbour of adc %d at %d", adc, pos);
+        }
+    }
+}
+
+static void test_blocks(void)
+{
+    /* Word-aligned buffers with room to start at any offset into a word */
+    static uint16_t adc[MAX_LEN + 4] __attribute__((aligned(4)));
+    static fad_q15_t q15[MAX_LEN + 4] __attribute__((aligned(4)));
+    static fad_q15_t back[MAX_LEN + 4] __attribute__((aligned(4)));
+    static uint8_t dac[MAX_LEN + 8] __attribute__((aligned(4)));
+    static int16_t stereo[2 * 3 * (MAX_LEN + 4)] __attribute__((aligned(4)));
+    static uint8_t packed[3 * (MAX_LEN + 4)];
+
+    fad_host_seed_random(1);
+    for (int len = 0; len <= MAX_LEN; len++)
+    {
+        for (int a = 0; a < 2; a++)
+        {
+            for (int b = 0; b < 4; b++)
+            {
+                uint16_t *in = adc + a;
+                fad_q15_t *q = q15 + (b & 1);
+                uint8_t *d = dac + b;
+
+                for (int i = 0; i < len; i++) in[i] = (uint16_t)(esp_random() & 0x0FFF);
+
+                /* ADC -> Q15, in place too */
+                fad_convert_adc_to_q15(in, q, len);
+                for (int i = 0; i < len; i++)
+                {
+                    FAD_CHECK(q[i] == fad_adc_to_q15(in[i]), "adc_to_q15 len %d align %d/%d at %d", len, a, b, i);
+                }
+                memcpy(back + a, in, len * sizeof(uint16_t));
+                fad_convert_adc_to_q15((uint16_t *)(back + a), back + a, len);
+                FAD_CHECK(memcmp(back + a, q, len * sizeof(fad_q15_t)) == 0, "adc_to_q15 in place len %d align %d", len, a);
+
+                /* Q15 -> DAC and back */
+                fad_convert_q15_to_dac(q, d, len);
+                for (int i = 0; i < len; i++)
+                {
+                    FAD_CHECK(d[i] == in[i] >> 4, "q15_to_dac len %d align %d/%d at %d", len, a, b, i);
+                }
+                fad_q15_t *r = back + (a ^ (b & 1));
+                fad_convert_dac_to_q15(d, r, len);
+                for (int i = 0; i < len; i++)
+                {
+                    FAD_CHECK(r[i] == fad_dac_to_q15(d[i]), "dac_to_q15 len %d align %d/%d at %d", len, a, b, i);
+                }
+
+                /* DAC -> stereo repeats each value on both channels */
+                int repeat = 1 + (b % 3);
+                fad_convert_dac_to_stereo(d, stereo, len, repeat);
+                for (int i = 0; i < len * repeat; i++)
+                {
+                    int16_t v = fad_dac_to_q15(d[i / repeat]);
+                    FAD_CHECK(stereo[2 * i] == v && stereo[2 * i + 1] == v, "dac_to_stereo len %d repeat %d at %d", len, repeat, i);
+                }
+
+                /* Q15 -> packed -> Q15 is lossless for ADC input */
+                int pairs = len / 2;
+                fad_convert_q15_to_packed12(q, packed, pairs);
+                for (int i = 0; i < 2 * pairs; i++)
+                {
+                    FAD_CHECK(fad_packed12_get(packed, i) == q[i], "q15_to_packed12 len %d at %d", len, i);
+                }
+                fad_convert_packed12_to_q15(packed, r, pairs);
+                FAD_CHECK(memcmp(r, q, 2 * pairs * sizeof(fad_q15_t)) == 0, "packed12 round trip len %d align %d/%d", len, a, b);
+            }
+        }
+    }
+}
+
+static void test_dc_block(void)
+{
+    enum { LEN = 2 * OUTPUT_FREQ, TAIL = 4410 };     // TAIL holds a whole number of periods of freq
+    static fad_q15_t x[LEN];
+    const double freq = 300.0;
+
+    /* A tone riding on a bias well off midscale */
+    for (int i = 0; i < LEN; i++) x[i] = (fad_q15_t)lrint(6000.0 + 8000.0 * sin(2.0 * FAD_TEST_PI * freq * i / OUTPUT_FREQ));
+
+    fad_dc_block_t dc;
+    fad_dc_block_init(&dc);
+    for (int i = 0; i < LEN; i += FAD_BLOCK_SIZE) fad_dc_block(&dc, x + i, LEN - i < FAD_BLOCK_SIZE ? LEN - i : FAD_BLOCK_SIZE);
+
+    const fad_q15_t *tail = x + LEN - TAIL;
+    double mean = 0.0;
+    for (int i = 0; i < TAIL; i++) mean += tail[i];
+    mean /= TAIL;
+    double amp = fad_test_amplitude(tail, TAIL, freq, OUTPUT_FREQ);
+
+    FAD_CHECK(fabs(mean) < 4.0, "bias left after 2 s: %.2f", mean);
+    FAD_CHECK(fabs(amp - 8000.0) < 80.0, "%.0f Hz amplitude %.0f, expected 8000", freq, amp);
+}
+
+int main(void)
+{
+    test_scalar();
+    test_blocks();
+    test_dc_block();
+    return fad_test_result("test_convert");
+}
@@ -0,0 +1,164 @@
+/**
+ * test_delay_line.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Delay line storage and reads. For each storage format, a recorded input is written block by block,
+ * with block sizes that do not divide the ring, and read back at whole delays: 8-bit and packed
+ * 12-bit lines must return exactly what their format keeps of each sample, and ADPCM must stay within
+ * its error bound. A fractional read at a whole delay must be bit-identical to the whole read, for both
+ * interpolators. At delays between samples, both interpolators must track a sampled sine.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "fad_convert.h"
+#include "fad_defs.h"
+#include "fad_delay_line.h"
+#include "fad_test.h"
+
+/* Input recorded per format, longer than any of the lines */
+#define SIGNAL_LEN 12000
+
+/* Bytes of each line */
+#define LINE_BYTES (36 * 80)
+
+/* Bound on the ADPCM error once the encoder has caught up, Q15: RMS and worst sample. The signal is about 7800 RMS, so about 30 dB SNR */
+#define ADPCM_MAX_RMS 300.0
+#define ADPCM_MAX_ERROR 1500
+
+static fad_q15_t s_signal[SIGNAL_LEN];
+static uint8_t s_buff[LINE_BYTES];
+
+/* Speech-band test signal as the ADC would capture it: two tones and noise, quantized to 12 bits */
+static void make_signal(void)
+{
+    fad_host_seed_random(7);
+    for (int i = 0; i < SIGNAL_LEN; i++)
+    {
+        double v = 0.3 * sin(2.0 * FAD_TEST_PI * 180.0 * i / OUTPUT_FREQ) + 0.15 * sin(2.0 * FAD_TEST_PI * 1130.0 * i / OUTPUT_FREQ);
+        int32_t adc = FAD_ADC_MIDSCALE + (int32_t)lrint(v * 2047.0) + fad_test_noise(20);
+        s_signal[i] = fad_adc_to_q15((uint16_t)adc);
+    }
+}
+
+/* What a lossless or 8-bit line returns for a sample */
+static fad_q15_t stored(fad_delay_line_format_t format, fad_q15_t x)
+{
+    return format == FAD_DELAY_LINE_U8 ? fad_dac_to_q15(fad_q15_to_dac(x)) : x;
+}
+
+static void test_format(fad_delay_line_format_t format, const char *name)
+{
+    static const int block_sizes[] = { 512, 100, 37, 511, 1 };
+    static fad_q15_t out[FAD_BLOCK_SIZE], frac[FAD_BLOCK_SIZE];
+
+    fad_delay_line_t line;
+    fad_delay_line_init(&line, format, s_buff, sizeof(s_buff));
+
+    double err2 = 0.0;
+    long err_count = 0;
+    int max_err = 0;
+
+    int written = 0;
+    for (int b = 0; written + FAD_BLOCK_SIZE <= SIGNAL_LEN; b++)
+    {
+        int len = block_sizes[b % 5];
+        fad_delay_line_write(&line, s_signal + written, len);
+        written += len;
+
+        /* Whole delays from the block length to the longest, where the line has been filled that far */
+        const int delays[] = { len, len + 1, 777, line.max_delay - 1, line.max_delay };
+        for (int d = 0; d < 5; d++)
+        {
+            int delay = delays[d];
+            if (delay < len || delay > line.max_delay || delay > written) continue;
+
+            fad_delay_line_read(&line, delay, out, len);
+            const fad_q15_t *expect = s_signal + written - delay;
+            for (int i = 0; i < len; i++)
+            {
+                if (format == FAD_DELAY_LINE_ADPCM)
+                {
+                    /* The encoder starts from its smallest step, so it takes a chunk to catch up with the input */
+                    if (expect + i >= s_signal + FAD_DELAY_LINE_CHUNK)
+                    {
+                        int e = abs(out[i] - expect[i]);
+                        if (e > max_err) max_err = e;
+                        err2 += (double)e * e;
+                        err_count++;
+                    }
+                }
+                else
+                {
+                    FAD_CHECK(out[i] == stored(format, expect[i]), "%s: delay %d sample %d: %d, expected %d", name, delay, i, out[i], stored(format, expect[i]));
+                }
+                FAD_CHECK(fad_delay_line_tap(&line, delay - i) == out[i], "%s: tap at delay %d", name, delay - i);
+            }
+
+            /* A fractional read at a whole delay is the whole read, for both interpolators */
+            for (int interp = FAD_DELAY_INTERP_LINEAR; interp <= FAD_DELAY_INTERP_LAGRANGE; interp++)
+            {
+                int32_t q16 = fad_delay_line_clamp(&line, (int32_t)delay << 16);
+                FAD_CHECK(q16 == (int32_t)delay << 16, "%s: clamp moved whole delay %d", name, delay);
+                fad_delay_line_read_frac(&line, q16, frac, len, interp);
+                FAD_CHECK(memcmp(frac, out, len * sizeof(fad_q15_t)) == 0, "%s: read_frac at whole delay %d, interp %d", name, delay, interp);
+                FAD_CHECK(fad_delay_line_tap_frac(&line, q16, interp) == out[0], "%s: tap_frac at whole delay %d", name, delay);
+            }
+        }
+    }
+
+    if (format == FAD_DELAY_LINE_ADPCM)
+    {
+        double rms = sqrt(err2 / err_count);
+        FAD_CHECK(rms < ADPCM_MAX_RMS, "%s: error RMS %.1f", name, rms);
+        FAD_CHECK(max_err < ADPCM_MAX_ERROR, "%s: worst error %d", name, max_err);
+    }
+}
+
+/* Interpolated reads between samples of a 500 Hz sine, against the sine itself */
+static void test_interpolation(void)
+{
+    enum { LEN = 2000, READ = 256 };
+    static fad_q15_t x[LEN], out[READ];
+    const double freq = 500.0, amp = 16000.0;
+
+    for (int i = 0; i < LEN; i++) x[i] = (fad_q15_t)lrint(amp * sin(2.0 * FAD_TEST_PI * freq * i / OUTPUT_FREQ));
+
+    fad_delay_line_t line;
+    fad_delay_line_init(&line, FAD_DELAY_LINE_PACKED12, s_buff, sizeof(s_buff));
+    fad_delay_line_write(&line, x, LEN);
+
+    /* Worst error allowed at each interpolator, Q15: linear dulls 500 Hz by about 1% halfway between samples, Lagrange by far less */
+    const int max_err[2] = { 200, 40 };
+    const int32_t fractions[] = { 0x4000, 0x8000, 0xC000, 0x1234 };
+    for (int interp = FAD_DELAY_INTERP_LINEAR; interp <= FAD_DELAY_INTERP_LAGRANGE; interp++)
+    {
+        for (int f = 0; f < 4; f++)
+        {
+            int32_t delay = (300 << 16) + fractions[f];
+            fad_delay_line_read_frac(&line, delay, out, READ, interp);
+
+            int worst = 0;
+            for (int i = 0; i < READ; i++)
+            {
+                /* Sample i lies delay behind the write position, which is at LEN */
+                double t = LEN - delay / 65536.0 + i;
+                int e = abs(out[i] - (int)lrint(amp * sin(2.0 * FAD_TEST_PI * freq * t / OUTPUT_FREQ)));
+                if (e > worst) worst = e;
+            }
+            FAD_CHECK(worst <= max_err[interp], "interp %d at fraction 0x%04x: worst error %d", interp, (unsigned)fractions[f], worst);
+        }
+    }
+}
+
+int main(void)
+{
+    make_signal();
+    test_format(FAD_DELAY_LINE_U8, "u8");
+    test_format(FAD_DELAY_LINE_PACKED12, "packed12");
+    test_format(FAD_DELAY_LINE_ADPCM, "adpcm");
+    test_interpolation();
+    return fad_test_result("test_delay_line");
+}
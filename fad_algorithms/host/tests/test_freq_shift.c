@@ -0,0 +1,62 @@
+/**
+ * test_freq_shift.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Frequency shift direction and image rejection. A 1 kHz tone is run through the chain in blocks, as
+ * the app does, in each mode: the output must sit at 1 kHz plus the mode's shift, while the input
+ * tone and the mirror image a ring modulator would leave (1 kHz less the shift) stay far below it.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "fad_chain.h"
+#include "fad_defs.h"
+#include "fad_test.h"
+
+#define LEN (2 * OUTPUT_FREQ)
+
+/* Measured over the last second, once the chain has settled */
+#define TAIL OUTPUT_FREQ
+
+static fad_q15_t s_scratch[2][DAC_BUFFER_SIZE];
+static uint8_t s_bank[FAD_ALGO_BANK_SIZE] __attribute__((aligned(FAD_ARENA_ALIGN)));
+static fad_q15_t s_in[LEN], s_out[LEN];
+
+static void test_mode(fad_algo_mode_t mode, double shift)
+{
+    const double freq = 1000.0, amp = 10000.0;
+    for (int i = 0; i < LEN; i++) s_in[i] = (fad_q15_t)lrint(amp * sin(2.0 * FAD_TEST_PI * freq * i / OUTPUT_FREQ));
+
+    fad_chain_t chain;
+    fad_chain_init(&chain, s_scratch[0], s_scratch[1], DAC_BUFFER_SIZE, s_bank, sizeof(s_bank));
+    FAD_CHECK(fad_chain_add(&chain, FAD_ALGO_FREQ_SHIFT, mode) == ESP_OK, "mode %d: could not add", mode + 1);
+
+    for (int i = 0; i + FAD_BLOCK_SIZE <= LEN; i += FAD_BLOCK_SIZE)
+    {
+        fad_span_t in_span;
+        fad_span_init(&in_span, s_in + i, FAD_BLOCK_SIZE, 0, FAD_BLOCK_SIZE);
+        const fad_span_t *out_span = fad_chain_run(&chain, &in_span);
+        memcpy(s_out + i, out_span->seg[0], FAD_BLOCK_SIZE * sizeof(fad_q15_t));
+    }
+    fad_chain_clear(&chain);
+
+    /* The blocks cover all but the last partial one */
+    const fad_q15_t *tail = s_out + LEN / FAD_BLOCK_SIZE * FAD_BLOCK_SIZE - TAIL;
+    double shifted = fad_test_amplitude(tail, TAIL, freq + shift, OUTPUT_FREQ);
+    double mirror = fad_test_amplitude(tail, TAIL, freq - shift, OUTPUT_FREQ);
+    double original = fad_test_amplitude(tail, TAIL, freq, OUTPUT_FREQ);
+
+    FAD_CHECK(shifted > 0.9 * amp, "mode %d: %.0f Hz at %.0f, expected near %.0f", mode + 1, freq + shift, shifted, amp);
+    FAD_CHECK(mirror < 0.01 * amp, "mode %d: mirror image at %.0f Hz is %.0f", mode + 1, freq - shift, mirror);
+    FAD_CHECK(original < 0.01 * amp, "mode %d: input tone left at %.0f", mode + 1, original);
+}
+
+int main(void)
+{
+    test_mode(FAD_ALGO_MODE_1, 100.0);
+    test_mode(FAD_ALGO_MODE_2, 200.0);
+    test_mode(FAD_ALGO_MODE_3, 400.0);
+    return fad_test_result("test_freq_shift");
+}
@@ -0,0 +1,91 @@
+/**
+ * test_nco.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Oscillators. The table sine must stay within its stated error of the true sine, with and without
+ * interpolation, and land on the frequency it was set to. The band-limited saw and triangle must hold
+ * their low harmonics near the ideal waveform's level, while the harmonics past Nyquist, which fold
+ * back into the band, stay well under what the naive waveform folds back.
+ */
+
+#include <stdint.h>
+#include "fad_defs.h"
+#include "fad_nco.h"
+#include "fad_test.h"
+
+#define LEN OUTPUT_FREQ
+
+static fad_q15_t s_out[LEN];
+
+static void test_sine(void)
+{
+    /* Worst error against the true sine, Q15. About -44 dB from the table alone, 2 LSB interpolated */
+    const int max_err[2] = { 210, 2 };
+    for (int interpolate = 0; interpolate < 2; interpolate++)
+    {
+        int worst = 0;
+        for (uint32_t phase = 0; phase < 0xFFFFF000u; phase += 0x00012345u)
+        {
+            int e = abs(fad_nco_sine(phase, interpolate) - (int)lrint(32767.0 * sin(2.0 * FAD_TEST_PI * phase / 4294967296.0)));
+            if (e > worst) worst = e;
+        }
+        FAD_CHECK(worst <= max_err[interpolate], "sine, interpolate %d: worst error %d", interpolate, worst);
+    }
+
+    /* A block lands on its frequency, and one set by period on the same one */
+    fad_nco_t nco;
+    fad_nco_init(&nco, 440, OUTPUT_FREQ, true);
+    fad_nco_sin(&nco, s_out, LEN);
+    double amp = fad_test_amplitude(s_out, LEN, 440.0, OUTPUT_FREQ);
+    FAD_CHECK(fabs(amp - 32767.0) < 40.0, "440 Hz sine amplitude %.0f", amp);
+    FAD_CHECK(fad_test_amplitude(s_out, LEN, 441.0, OUTPUT_FREQ) < 40.0, "440 Hz sine leaks into 441 Hz");
+
+    fad_nco_set_period(&nco, (int32_t)lrint(65536.0 * OUTPUT_FREQ / 440.0));
+    fad_nco_sin(&nco, s_out, LEN);
+    amp = fad_test_amplitude(s_out, LEN, 440.0, OUTPUT_FREQ);
+    FAD_CHECK(fabs(amp - 32767.0) < 40.0, "440 Hz sine set by period, amplitude %.0f", amp);
+}
+
+/*
+ * A waveform whose harmonics fall as 1 / k (saw) or 1 / k^2, odd only (triangle). At 440 Hz, harmonics
+ * 1 and 3 are well inside the band and must be within 5% of ideal. At 1234 Hz, harmonics 5 and 7 lie past
+ * Nyquist and fold back to 4855 and 2387 Hz, where a naive waveform would put their full level
+ */
+static void test_shape(void (*produce)(fad_nco_t *, fad_q15_t *, int), const char *name, int power)
+{
+    /* Ideal harmonic levels: saw 2 / (pi k), triangle 8 / (pi k)^2 */
+    double scale = power == 1 ? 2.0 / FAD_TEST_PI : 8.0 / (FAD_TEST_PI * FAD_TEST_PI);
+
+    fad_nco_t nco;
+    fad_nco_init(&nco, 440, OUTPUT_FREQ, false);
+    produce(&nco, s_out, LEN);
+    for (int k = 1; k <= 3; k += 2)
+    {
+        double ideal = 32767.0 * scale / pow(k, power);
+        double amp = fad_test_amplitude(s_out, LEN, 440.0 * k, OUTPUT_FREQ);
+        FAD_CHECK(fabs(amp - ideal) < 0.05 * ideal, "%s harmonic %d of 440 Hz: %.0f, ideal %.0f", name, k, amp, ideal);
+    }
+
+    /* The PolyBLEP corner leaves about a third of harmonic 5 and a fifteenth of harmonic 7 */
+    const int folded[] = { 5, 7 };
+    const double max_alias[] = { 0.4, 0.1 };
+    fad_nco_init(&nco, 1234, OUTPUT_FREQ, false);
+    produce(&nco, s_out, LEN);
+    for (int h = 0; h < 2; h++)
+    {
+        int k = folded[h];
+        double naive = 32767.0 * scale / pow(k, power);
+        double alias = fad_test_amplitude(s_out, LEN, OUTPUT_FREQ - k * 1234.0, OUTPUT_FREQ);
+        FAD_CHECK(alias < max_alias[h] * naive, "%s harmonic %d of 1234 Hz folded to %.0f Hz: %.0f, naive %.0f", name, k, OUTPUT_FREQ - k * 1234.0, alias, naive);
+    }
+}
+
+int main(void)
+{
+    test_sine();
+    test_shape(fad_nco_saw, "saw", 1);
+    test_shape(fad_nco_triangle, "triangle", 2);
+    return fad_test_result("test_nco");
+}
@@ -0,0 +1,139 @@
+/**
+ * test_pitch.c
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Pitch estimators on synthetic voiced tones: harmonics with falling levels, fed in blocks as the app
+ * does. On clean tones from 60 to 490 Hz, both HPS and YIN must find the fundamental within 2% and
+ * call it voiced. With uniform noise at -3 dB SNR, every estimate HPS calls voiced must still be
+ * within 2%, and at least half must be voiced. On white noise alone, HPS must call none of 200 fresh
+ * frames voiced.
+ */
+
+#include <stdint.h>
+#include "fad_defs.h"
+#include "fad_pitch.h"
+#include "fad_test.h"
+
+/* Harmonics in a test tone, one more than HPS multiplies */
+#define HARMONICS 5
+
+/* Input per tone. The first second fills the estimators; every block after it is checked */
+#define LEN (2 * OUTPUT_FREQ)
+#define SETTLE OUTPUT_FREQ
+
+/* Highest tone YIN is held to: the top of its search range */
+#define YIN_MAX_HZ 500.0
+
+/* Largest error allowed, as a fraction of the fundamental */
+#define MAX_ERROR 0.02
+
+static const double s_tones[] = { 60.0, 90.0, 130.0, 180.0, 250.0, 330.0, 410.0, 490.0 };
+#define TONE_COUNT (int)(sizeof(s_tones) / sizeof(s_tones[0]))
+
+static fad_q15_t s_in[LEN];
+static fad_pitch_hps_t s_hps;
+
+static double estimate_hz(const fad_pitch_t *est)
+{
+    return fad_pitch_hz(est->period) / 65536.0;
+}
+
+/* Add uniform noise at snr_db below the power of the samples */
+static void add_noise(fad_q15_t *x, int len, double snr_db)
+{
+    double power = 0.0;
+    for (int i = 0; i < len; i++) power += (double)x[i] * x[i];
+    power /= len;
+
+    /* Uniform noise of amplitude a has power a^2 / 3 */
+    int amp = (int)lrint(sqrt(3.0 * power * pow(10.0, -snr_db / 10.0)));
+    for (int i = 0; i < len; i++) x[i] = fad_sat_q15((int32_t)x[i] + fad_test_noise(amp));
+}
+
+/*
+ * Run YIN (if yin) or HPS over s_in and check every estimate past SETTLE against f0. Clean tones must
+ * give voiced estimates within MAX_ERROR; noisy ones may give unvoiced estimates, which the masker does
+ * not follow, but every voiced one must be within MAX_ERROR. Adds the estimates to voiced and total
+ */
+static void check_tone(double f0, bool yin, bool noisy, int *voiced, int *total)
+{
+    static fad_pitch_yin_t tracker;
+    fad_pitch_yin_init(&tracker);
+    fad_pitch_hps_init(&s_hps, 1);
+
+    for (int i = 0; i + FAD_BLOCK_SIZE <= LEN; i += FAD_BLOCK_SIZE)
+    {
+        fad_pitch_t est;
+        if (yin)
+        {
+            fad_pitch_yin_write(&tracker, s_in + i, FAD_BLOCK_SIZE);
+            fad_pitch_yin_estimate(&tracker, &est);
+        }
+        else
+        {
+            fad_pitch_hps_write(&s_hps, s_in + i, FAD_BLOCK_SIZE);
+            if (!fad_pitch_hps_estimate(&s_hps, &est)) continue;
+        }
+        if (i < SETTLE) continue;
+
+        (*total)++;
+        if (est.voiced) (*voiced)++;
+        else if (noisy) continue;
+
+        double hz = estimate_hz(&est);
+        FAD_CHECK(fabs(hz - f0) <= MAX_ERROR * f0, "%s %.0f Hz%s: estimated %.1f Hz at sample %d", yin ? "yin" : "hps", f0, noisy ? " in noise" : "", hz, i);
+        FAD_CHECK(est.voiced, "%s %.0f Hz: not voiced at sample %d, confidence %d", yin ? "yin" : "hps", f0, i, est.confidence);
+    }
+}
+
+static void test_tones(void)
+{
+    int voiced = 0, total = 0;
+    fad_host_seed_random(3);
+    for (int t = 0; t < TONE_COUNT; t++)
+    {
+        fad_test_harmonic_tone(s_in, LEN, s_tones[t], HARMONICS, 0.5, 0, OUTPUT_FREQ);
+        if (s_tones[t] <= YIN_MAX_HZ) check_tone(s_tones[t], true, false, &voiced, &total);
+        check_tone(s_tones[t], false, false, &voiced, &total);
+    }
+    FAD_CHECK(total > 0, "clean tones: no estimates");
+
+    /* Quieter, so the noise does not clip */
+    voiced = total = 0;
+    for (int t = 0; t < TONE_COUNT; t++)
+    {
+        fad_test_harmonic_tone(s_in, LEN, s_tones[t], HARMONICS, 0.25, 0, OUTPUT_FREQ);
+        add_noise(s_in, LEN, -3.0);
+        check_tone(s_tones[t], false, true, &voiced, &total);
+    }
+    FAD_CHECK(2 * voiced >= total, "hps at -3 dB SNR: only %d of %d estimates voiced", voiced, total);
+}
+
+static void test_noise(void)
+{
+    enum { FRAMES = 200, FRAME_LEN = FAD_PITCH_HPS_FRAME * FAD_PITCH_HPS_DECIMATE };
+    fad_host_seed_random(5);
+    fad_pitch_hps_init(&s_hps, 1);
+
+    int voiced = 0;
+    for (int f = 0; f < FRAMES; f++)
+    {
+        /* A whole new frame of noise per estimate */
+        for (int i = 0; i < FRAME_LEN; i++) s_in[i] = fad_test_noise(10000);
+        fad_pitch_hps_write(&s_hps, s_in, FRAME_LEN);
+
+        fad_pitch_t est;
+        FAD_CHECK(fad_pitch_hps_estimate(&s_hps, &est), "hps: no estimate at interval 1");
+        if (est.voiced) voiced++;
+    }
+    FAD_CHECK(voiced == 0, "hps: %d of %d white-noise frames voiced", voiced, FRAMES);
+}
+
+int main(void)
+{
+    test_tones();
+    test_noise();
+    return fad_test_result("test_pitch");
+}
@@ -8,36 +8,80 @@
  * This file returns a delayed version of the input signal, shifted by some target amount.
  */
 
+#ifndef _ALGO_DELAY_H_
+#define _ALGO_DELAY_H_
+
 #include <stdint.h>
 #include "fad_defs.h"
+#include "fad_delay_line.h"
+
+/* Bytes of delay line storage per instance. Holds 800 ms at OUTPUT_FREQ as 8-bit samples, about 1.4 s as ADPCM, or 533 ms as packed 12-bit */
+#define ALGO_DELAY_BUFFER_SIZE 8820
+
+/* Number of samples a delay change is spread over (about 40 ms at OUTPUT_FREQ) */
+#define ALGO_DELAY_RAMP_LEN 441
+
+/* Instance state */
+typedef struct {
+    /* The delay line over delay_buffer, in the storage format of the mode. */
+    fad_delay_line_t line;
 
-/* Defines how many values the algorithm will read from the ADC buffer. Should always be at least half of buffer size. */
-int algo_delay_read_size_g;
+    /* The current delay in output samples, Q16. The read position is this far behind the write position. Slews toward delay_target. */
+    int32_t delay;
 
-/* Define any globals */
-/* This delay size determines how many samples (in terms of output) to shift the incoming signal by. Determines delay time. */
-int delay_size_g;
+    /* The delay set by algo_delay_set_delay_ms in output samples, Q16. Need not be a whole number of samples. */
+    int32_t delay_target;
 
-/* This is a circular buffer that holds signals for the output delay. Needs to be allocated based on the sample delay amount. */
-uint8_t *delay_buffer_g;
+    /* Change of delay per sample while ramping, Q16. */
+    int32_t delay_step;
 
-/* This is the current position in the delay buffer. */
-int delay_buffer_pos_g;
+    /* Samples left until delay reaches delay_target. 0 when settled. */
+    int ramp_remaining;
+
+    /* How values between samples are read. */
+    fad_delay_interp_t interp;
+
+    /* This is a circular buffer that holds signals for the output delay. Inline, and always the full length, so the delay can change without reallocating. */
+    uint8_t delay_buffer[ALGO_DELAY_BUFFER_SIZE];
+} algo_delay_ctx_t;
+
+/* Bytes of state held by the algorithm */
+#define ALGO_DELAY_STATE_SIZE sizeof(algo_delay_ctx_t)
 
 /**
  * @brief Delay algorithm for ESP masker
- * @param in_buff Buffer that points to the beginning of the ADC data
- * @param out_buff [OUT] Buffer that points to the beggining of DAC data staged to be output to the DAC
- * @param in_pos Points to starting point of this algorithm chunk
- * @param out_pos Points to starting point of this algorithm chunk
- * @param multisamples Number of input samples per output sample
+ * @param ctx The algo_delay_ctx_t of this instance
+ * @param in The block of input samples
+ * @param out [OUT] The block of output samples
  */
-void algo_delay(uint16_t *in_buff, uint8_t *out_buff, uint16_t in_pos, uint16_t out_pos, int multisamples); 
+void algo_delay(void *ctx, const fad_span_t *in, const fad_span_t *out);
 
 /**
  * @brief Initializes algorithm constants
- * @param algo_size The amount of data to process from the input
+ * @param ctx [OUT] The algo_delay_ctx_t of this instance
+ * @param params The params of data to process from the input. Uses algo_delay_params.
+ */
+void algo_delay_init(void *ctx, fad_algo_init_params_t *params);
+
+/**
+ * @brief Retune a running instance to another mode's delay. The delay ramps to the new value; the buffer is kept.
+ * @param ctx The algo_delay_ctx_t of this instance
+ * @param params The params of the new mode. Uses algo_delay_params.delay_ms.
+ */
+void algo_delay_update(void *ctx, fad_algo_init_params_t *params);
+
+/**
+ * @brief Set the delay time while running. The read position slews to the new delay over ALGO_DELAY_RAMP_LEN
+ * samples instead of jumping, so the output has no gap or click. Safe to call between blocks at any time, including mid-ramp.
+ * @param ctx The algo_delay_ctx_t of this instance
+ * @param delay_ms The delay in milliseconds. Clamped to 1 sample .. the longest delay the storage format holds
+ */
+void algo_delay_set_delay_ms(void *ctx, int delay_ms);
+
+/**
+ * @brief Deinitalize the function
+ * @param ctx The algo_delay_ctx_t of this instance
  */
-void algo_delay_init();  //fad_algo_init_params_t *params
+void algo_delay_deinit(void *ctx);
 
-void algo_delay_deinit();
\ No newline at end of file
+#endif
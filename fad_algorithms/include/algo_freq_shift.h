@@ -5,38 +5,56 @@
  * Date: 10/12/2020
  *
  * Description:
- * This file returns the input signal at a different pitch, shifted by some target amount.
+ * This file returns the input signal with every frequency moved by some target amount, in Hz.
  */
 
-
+#ifndef _ALGO_FREQ_SHIFT_H_
+#define _ALGO_FREQ_SHIFT_H_
 
 #include <stdint.h>
-#include <math.h>
-
-
-
+#include "fad_defs.h"
+#include "fad_nco.h"
+
+/* Allpass sections in each chain of the Hilbert transformer */
+#define ALGO_FREQ_SHIFT_SECTIONS 4
+
+/* State of one second-order allpass section */
+typedef struct {
+    int32_t x1, x2;     // Last two inputs
+    int32_t y1, y2;     // Last two outputs
+} algo_freq_shift_allpass_t;
+
+/* Instance state */
+typedef struct {
+    int shift_amount;           // Shift amount in Hz
+    algo_freq_shift_allpass_t path_i[ALGO_FREQ_SHIFT_SECTIONS];    // Allpass chain giving the in-phase signal
+    algo_freq_shift_allpass_t path_q[ALGO_FREQ_SHIFT_SECTIONS];    // Allpass chain giving the quadrature signal
+    int32_t q_delay;            // One sample delay after path_q
+    fad_nco_t osc;              // Quadrature oscillator at shift_amount
+} algo_freq_shift_ctx_t;
+
+/* Bytes of state held by the algorithm */
+#define ALGO_FREQ_SHIFT_STATE_SIZE sizeof(algo_freq_shift_ctx_t)
 
 /**
- * @brief Frequency shifter...
- * @param in_buff
- * @param 
- * @param   
+ * @brief Single-sideband frequency shifter for ESP masker. Moves every frequency by shift_amount Hz
+ * @param ctx The algo_freq_shift_ctx_t of this instance
+ * @param in The block of input samples
+ * @param out [OUT] The block of output samples
  */
-void algo_freq_shift(uint16_t *in_buff, uint8_t *out_buff, uint16_t in_pos, uint16_t out_pos, int multisamples);
-
+void algo_freq_shift(void *ctx, const fad_span_t *in, const fad_span_t *out);
 
-
-/** 
+/**
+ * @brief Initializes algorithm constants
+ * @param ctx [OUT] The algo_freq_shift_ctx_t of this instance
+ * @param params The params of data to process from the input. Uses algo_freq_shift_params.
  */
-void algo_freq_init();
-
-void algo_freq_deinit();
-
-
-
-
-
-
-
+void algo_freq_init(void *ctx, fad_algo_init_params_t *params);
 
+/**
+ * @brief Deinitalize the function. Remove memory allocations, etc.
+ * @param ctx The algo_freq_shift_ctx_t of this instance
+ */
+void algo_freq_deinit(void *ctx);
 
+#endif
@@ -0,0 +1,45 @@
+/**
+ * algo_gain.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Scales the input signal around its center value. Meant as the last stage of an algorithm chain.
+ */
+
+#ifndef _ALGO_GAIN_H_
+#define _ALGO_GAIN_H_
+
+#include <stdint.h>
+#include "fad_defs.h"
+
+/* Instance state */
+typedef struct {
+    int gain_q8;    // Gain, 256 = unity
+} algo_gain_ctx_t;
+
+/* Bytes of state held by the algorithm */
+#define ALGO_GAIN_STATE_SIZE sizeof(algo_gain_ctx_t)
+
+/**
+ * @brief Gain algorithm for ESP masker. Output saturates to the Q15 range.
+ * @param ctx The algo_gain_ctx_t of this instance
+ * @param in The block of input samples
+ * @param out [OUT] The block of output samples
+ */
+void algo_gain(void *ctx, const fad_span_t *in, const fad_span_t *out);
+
+/**
+ * @brief Initializes algorithm constants
+ * @param ctx [OUT] The algo_gain_ctx_t of this instance
+ * @param params The params of data to process from the input. Uses algo_gain_params.
+ */
+void algo_gain_init(void *ctx, fad_algo_init_params_t *params);
+
+/**
+ * @brief Deinitalize the function. Nothing is allocated, so this is empty.
+ * @param ctx The algo_gain_ctx_t of this instance
+ */
+void algo_gain_deinit(void *ctx);
+
+#endif
@@ -5,34 +5,59 @@
  * Date: 10/12/2020
  *
  * Description:
- * This algo imitates the Edinburgh Masker by finding the fft of the input data over a sampled period and
- * using this to create a sawtooth wave at the frequency of the found fundamental frequency.
+ * This algo imitates the Edinburgh Masker by tracking the pitch of the input (fad_pitch.h)
+ * and using this to create a band-limited sawtooth or triangle wave at the frequency of the found fundamental
+ * frequency.
  */
 
+#ifndef _ALGO_MASKING_H_
+#define _ALGO_MASKING_H_
+
 #include <stdint.h>
-#include <math.h>
+#include <stdbool.h>
 #include "fad_defs.h"
-#include "fft.h"
+#include "fad_fixed.h"
+#include "fad_pitch.h"
+#include "fad_nco.h"
+
+/* Peak level of the masker, Q15. Just under full scale, leaving room for the rounded-off corners */
+#define ALGO_MASKING_LEVEL FAD_Q15(0.9)
 
-/* Define any globals */
+/* Instance state. Fixed point, so the per-sample path has no division */
+typedef struct {
+    fad_pitch_source_t source;  // Which estimator tracks the pitch of the input
+    union {
+        fad_pitch_yin_t yin;
+        fad_pitch_hps_t hps;
+    } tracker;
+    fad_pitch_t pitch;          // The latest estimate
+    fad_masker_wave_t wave;     // Waveform of the masker
+    fad_nco_t osc;              // The masker's phase. Its step is set from the pitch once per block
+    fad_q15_t level;            // Peak level of the masker, Q15
+} algo_masking_ctx_t;
+
+/* Bytes of state held by the algorithm */
+#define ALGO_MASKING_STATE_SIZE sizeof(algo_masking_ctx_t)
 
 /**
- * @brief White noise algorithm for ESP masker
- * @param in_buff Buffer that points to the beginning of the ADC data
- * @param out_buff [OUT] Buffer that points to the beggining of DAC data staged to be output to the DAC
- * @param in_pos Points to starting point of this algorithm chunk
- * @param out_pos Points to starting point of this algorithm chunk
- * @param multisamples Number of input samples per output sample
+ * @brief Masking algorithm for ESP masker
+ * @param ctx The algo_masking_ctx_t of this instance
+ * @param in The block of input samples
+ * @param out [OUT] The block of output samples
  */
-void algo_masking(uint16_t *in_buff, uint8_t *out_buff, uint16_t in_pos, uint16_t out_pos, int multisamples); 
+void algo_masking(void *ctx, const fad_span_t *in, const fad_span_t *out);
 
 /**
  * @brief Initializes algorithm constants
+ * @param ctx [OUT] The algo_masking_ctx_t of this instance
  * @param params The params of data to process from the input
  */
-void algo_masking_init(); //fad_algo_init_params_t *params
+void algo_masking_init(void *ctx, fad_algo_init_params_t *params);
 
 /**
  * @brief Deinitalize the function. Remove memory allocations, etc.
+ * @param ctx The algo_masking_ctx_t of this instance
  */
-void algo_masking_deinit();
\ No newline at end of file
+void algo_masking_deinit(void *ctx);
+
+#endif
\ No newline at end of file
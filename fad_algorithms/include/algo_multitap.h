@@ -0,0 +1,58 @@
+/**
+ * algo_multitap.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Repeats the input as several echoes, each at its own delay and gain, read from one shared delay
+ * line. Memory is that of the longest tap, and the work per sample grows with the number of taps.
+ */
+
+#ifndef _ALGO_MULTITAP_H_
+#define _ALGO_MULTITAP_H_
+
+#include <stdint.h>
+#include "fad_defs.h"
+#include "fad_delay_line.h"
+
+/* Bytes of delay line storage per instance. Holds 600 ms at OUTPUT_FREQ as 8-bit samples */
+#define ALGO_MULTITAP_BUFFER_SIZE 6615
+
+/* Samples mixed per pass over the taps. Bounds the stack used by the algorithm */
+#define ALGO_MULTITAP_CHUNK 64
+
+/* Instance state */
+typedef struct {
+    int num_taps;
+    int32_t tap_delay[ALGO_MULTITAP_MAX_TAPS];  // Delay of each tap in output samples, Q16. Taps between samples are interpolated linearly
+    fad_q15_t tap_gain[ALGO_MULTITAP_MAX_TAPS]; // Gain of each tap, Q15
+    int min_delay;                              // Most samples every tap can read per pass
+    fad_delay_line_t line;                      // The delay line over delay_buffer, shared by every tap
+    uint8_t delay_buffer[ALGO_MULTITAP_BUFFER_SIZE];    // Storage of line, inline
+} algo_multitap_ctx_t;
+
+/* Bytes of state held by the algorithm */
+#define ALGO_MULTITAP_STATE_SIZE sizeof(algo_multitap_ctx_t)
+
+/**
+ * @brief Multi-tap delay algorithm for ESP masker. Output is the sum of the taps, saturated to the Q15 range.
+ * @param ctx The algo_multitap_ctx_t of this instance
+ * @param in The block of input samples
+ * @param out [OUT] The block of output samples
+ */
+void algo_multitap(void *ctx, const fad_span_t *in, const fad_span_t *out);
+
+/**
+ * @brief Initializes algorithm constants
+ * @param ctx [OUT] The algo_multitap_ctx_t of this instance
+ * @param params The params of data to process from the input. Uses algo_multitap_params.
+ */
+void algo_multitap_init(void *ctx, fad_algo_init_params_t *params);
+
+/**
+ * @brief Deinitalize the function
+ * @param ctx The algo_multitap_ctx_t of this instance
+ */
+void algo_multitap_deinit(void *ctx);
+
+#endif
@@ -0,0 +1,98 @@
+/**
+ * algo_registry.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Constant table describing every algorithm in fad_algorithms. Each entry holds the algorithm's
+ * functions, its preferred read size, its state footprint, and the init params for each mode.
+ * Switching algorithms is a single lookup into this table.
+ */
+
+#ifndef _ALGO_REGISTRY_H_
+#define _ALGO_REGISTRY_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "fad_defs.h"
+#include "fad_arena.h"
+#include "algo_template.h"
+#include "algo_delay.h"
+#include "algo_freq_shift.h"
+#include "algo_masking.h"
+#include "algo_white.h"
+#include "algo_gain.h"
+#include "algo_multitap.h"
+#include "algo_wsola.h"
+#include "algo_vocoder.h"
+
+/* Most algorithms a single chain may run per block */
+#define FAD_ALGO_MAX_STAGES 4
+
+/*
+ * Describes one algorithm. One entry per fad_algo_type_t.
+ * An entry with num_stages > 0 is a chain of other algorithms rather than an algorithm itself. It has no
+ * functions or state of its own; each stage is initialized with its own entry's params for the same mode.
+ *
+ * An algorithm's state is one ctx struct of state_size bytes, which the chain takes from its arena bank
+ * before init and hands back after deinit. Buffers (delay lines, rings, FFT frames) are held inline in
+ * that struct rather than allocated, so an instance is one contiguous block that never touches the heap
+ * and is released with the bank; deinit only undoes what init did beyond ctx, which for most is nothing.
+ * The largest struct sets FAD_ALGO_BANK_SIZE, which the app reserves once per chain at boot.
+ */
+typedef struct {
+    const char *name;                   // Name for logging
+    algo_init_func_t init;              // Initialization function
+    algo_func_t process;                // Algorithm function, called once per read_size ADC values
+    algo_deinit_func_t deinit;          // Deinitialization function
+    algo_update_func_t update;          // Optional. Retunes a running instance to another mode
+    int read_size;                      // ADC values per algorithm call. FAD_BLOCK_SIZE, which the app's timer is fixed to
+    size_t state_size;                  // Bytes of state held while active, buffers included. Taken from the chain's arena bank
+    bool gated;                         // Only run while the chain hears voice; silence is output otherwise. For algorithms with no output of their own during silence, and latency under FAD_VAD_HANGOVER
+    fad_algo_init_params_t mode_params[FAD_ALGO_MODE_COUNT];   // Init params for each fad_algo_mode_t
+    int num_stages;                     // Chains only: number of stages
+    fad_algo_type_t stages[FAD_ALGO_MAX_STAGES];    // Chains only: algorithms to run, in order
+} fad_algo_desc_t;
+
+/*
+ * Every state layout a registry entry can need: a member for each algorithm, and a struct for each chain
+ * entry holding its stages' states. Only used for its size. Add new algorithms and chain entries here.
+ */
+typedef union {
+    algo_delay_ctx_t delay;
+    algo_freq_shift_ctx_t freq_shift;
+    algo_masking_ctx_t masking;
+    algo_template_ctx_t templ;
+    algo_white_ctx_t white;
+    algo_gain_ctx_t gain;
+    algo_multitap_ctx_t multitap;
+    algo_wsola_ctx_t wsola;
+    algo_vocoder_ctx_t vocoder;
+    struct {
+        algo_delay_ctx_t delay;
+        algo_freq_shift_ctx_t freq_shift;
+    } delay_freq_shift;
+} fad_algo_state_t;
+
+/* Bytes of arena one chain needs to hold any registry entry: the largest state, plus alignment padding per stage */
+#define FAD_ALGO_BANK_SIZE FAD_ARENA_ROUND(sizeof(fad_algo_state_t) + FAD_ALGO_MAX_STAGES * FAD_ARENA_ALIGN)
+
+/* The algorithm table, indexed by fad_algo_type_t */
+extern const fad_algo_desc_t fad_algo_registry[FAD_ALGO_COUNT];
+
+/**
+ * @brief Look up the descriptor of an algorithm
+ * @param type The algorithm type
+ * @return Pointer to the descriptor, or NULL if type is out of range
+ */
+const fad_algo_desc_t *fad_algo_get_desc(fad_algo_type_t type);
+
+/**
+ * @brief Look up the init params of an algorithm mode
+ * @param desc The algorithm descriptor
+ * @param mode The algorithm mode. Out of range modes fall back to FAD_ALGO_MODE_1.
+ * @return Pointer to the init params for the mode
+ */
+const fad_algo_init_params_t *fad_algo_get_params(const fad_algo_desc_t *desc, fad_algo_mode_t mode);
+
+#endif
@@ -8,28 +8,40 @@
  * This file demonstrates the template for the algorithm file.
  */
 
+#ifndef _ALGO_TEMPLATE_H_
+#define _ALGO_TEMPLATE_H_
+
 #include <stdint.h>
 #include "fad_defs.h"
 
-/* Define any globals */
+/* Instance state. Keep every variable the algorithm needs between calls in here, not in globals. */
+typedef struct {
+    /* Determines the period of the square wave */
+    int period;
+} algo_template_ctx_t;
+
+/* Bytes of state held by the algorithm */
+#define ALGO_TEMPLATE_STATE_SIZE sizeof(algo_template_ctx_t)
 
 /**
- * @brief White noise algorithm for ESP masker
- * @param in_buff Buffer that points to the beginning of the ADC data
- * @param out_buff [OUT] Buffer that points to the beggining of DAC data staged to be output to the DAC
- * @param in_pos Points to starting point of this algorithm chunk
- * @param out_pos Points to starting point of this algorithm chunk
- * @param multisamples Number of input samples per output sample
+ * @brief Template algorithm for ESP masker
+ * @param ctx The algo_template_ctx_t of this instance
+ * @param in The block of input samples
+ * @param out [OUT] The block of output samples
  */
-void algo_template(uint16_t *in_buff, uint8_t *out_buff, uint16_t in_pos, uint16_t out_pos, int multisamples); 
+void algo_template(void *ctx, const fad_span_t *in, const fad_span_t *out);
 
 /**
  * @brief Initializes algorithm constants
+ * @param ctx [OUT] The algo_template_ctx_t of this instance
  * @param params The params of data to process from the input
  */
-void algo_template_init(fad_algo_init_params_t *params);
+void algo_template_init(void *ctx, fad_algo_init_params_t *params);
 
 /**
  * @brief Deinitalize the function. Remove memory allocations, etc.
+ * @param ctx The algo_template_ctx_t of this instance
  */
-void algo_template_deinit();
\ No newline at end of file
+void algo_template_deinit(void *ctx);
+
+#endif
@@ -0,0 +1,81 @@
+/**
+ * algo_vocoder.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Phase-vocoder pitch shifter. The input is cut into Hann-windowed frames every hop samples and taken
+ * to the frequency domain with rfft. The true frequency of each bin is estimated from its phase
+ * advance since the last frame, every partial is moved to its frequency times the pitch ratio, and
+ * the phases are accumulated at the new frequencies so they stay continuous from frame to frame. The
+ * frames are brought back with irfft, windowed again and overlap-added.
+ *
+ * This is the reference-quality shifter: it keeps the timing of the input exactly and has no splices,
+ * at the cost of float math and more memory and latency than algo_wsola. Each mode picks a frame size
+ * and hop: longer frames resolve low voices better, at a latency of one frame, and shorter hops smear
+ * transients less, at a transform per hop.
+ */
+
+#ifndef _ALGO_VOCODER_H_
+#define _ALGO_VOCODER_H_
+
+#include <stdint.h>
+#include "fad_defs.h"
+#include "fft.h"
+
+/* Longest frame a mode may use, in samples. A power of two; sets the size of the state. At 256 the state stays under algo_masking's, so it does not set FAD_ALGO_BANK_SIZE */
+#define ALGO_VOCODER_MAX_FRAME 256
+
+/* Frequency bins of the longest frame, DC to Nyquist */
+#define ALGO_VOCODER_MAX_BINS (ALGO_VOCODER_MAX_FRAME / 2 + 1)
+
+/* Instance state. Every buffer is sized for ALGO_VOCODER_MAX_FRAME */
+typedef struct {
+    int frame_size;         // Samples per frame. A power of two
+    int hop;                // Samples between frames. At most frame_size / 4
+    int fill;               // Samples in in_fifo. Starts at frame_size - hop
+    float ratio;            // Pitch ratio
+
+    fft_config_t fft_fwd;
+    fft_config_t fft_inv;
+
+    fad_q15_t in_fifo[ALGO_VOCODER_MAX_FRAME];      // The samples of the next frame
+    fad_q15_t out_fifo[ALGO_VOCODER_MAX_FRAME];     // The finished output of the last frame, hop samples
+    float window[ALGO_VOCODER_MAX_FRAME];           // Hann window
+    float frame[ALGO_VOCODER_MAX_FRAME];            // Time-domain frame, into rfft and out of irfft
+    float spectrum[ALGO_VOCODER_MAX_FRAME];         // rfft output: DC and Nyquist, then re/im pairs
+    float twiddles[FFT_TWIDDLE_LEN(ALGO_VOCODER_MAX_FRAME)];    // Shared by both transforms
+    float accum[ALGO_VOCODER_MAX_FRAME];            // Overlap-add of the synthesized frames
+
+    /* Per bin */
+    float last_phase[ALGO_VOCODER_MAX_BINS];    // Analysis phase in the last frame
+    float rot[ALGO_VOCODER_MAX_BINS];           // Phase rotation of the peak region each bin lay in last frame, accumulated
+    float ana_mag[ALGO_VOCODER_MAX_BINS];       // Analysis magnitude
+    float ana_phase[ALGO_VOCODER_MAX_BINS];     // Analysis phase
+} algo_vocoder_ctx_t;
+
+/* Bytes of state held by the algorithm */
+#define ALGO_VOCODER_STATE_SIZE sizeof(algo_vocoder_ctx_t)
+
+/**
+ * @brief Phase-vocoder pitch shift algorithm for ESP masker
+ * @param ctx The algo_vocoder_ctx_t of this instance
+ * @param in The block of input samples
+ * @param out [OUT] The block of output samples
+ */
+void algo_vocoder(void *ctx, const fad_span_t *in, const fad_span_t *out);
+
+/**
+ * @brief Initializes algorithm constants
+ * @param ctx [OUT] The algo_vocoder_ctx_t of this instance
+ * @param params The params of data to process from the input. Uses algo_vocoder_params.
+ */
+void algo_vocoder_init(void *ctx, fad_algo_init_params_t *params);
+
+/**
+ * @brief Deinitalize the function
+ * @param ctx The algo_vocoder_ctx_t of this instance
+ */
+void algo_vocoder_deinit(void *ctx);
+
+#endif
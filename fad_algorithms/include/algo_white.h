@@ -9,25 +9,40 @@
  * Bit-wise AND with the input ADC and a pseudo-random number from esp_random 
  */
 
+#ifndef _ALGO_WHITE_H_
+#define _ALGO_WHITE_H_
+
 #include <stdint.h>
+#include "fad_defs.h"
 
+/* Instance state */
+typedef struct {
+	/* Last input value of the previous block, so the derivative carries across blocks */
+	fad_q15_t prev;
+} algo_white_ctx_t;
 
-/* Usable portion of buffer to perform the algorithm, as other portions fill up */
-int algo_white_size;
+/* Bytes of state held by the algorithm */
+#define ALGO_WHITE_STATE_SIZE sizeof(algo_white_ctx_t)
 
 /**
  * @brief White noise algorithm for ESP masker
- * @param in_buff  Buffer that points to the beginning of the ADC data. Must be multisamples times larger
- *                  than out_buff
- * @param out_buff  [OUT] Buffer that points to the beggining of DAC data staged to be output to the DAC
- * @param in_pos   Points to starting point of this algorithm chunk
- * @param out_pos   Points to starting point of this algorithm chunk.
- * @param multisamples  The number of input data per output
+ * @param ctx The algo_white_ctx_t of this instance
+ * @param in  The block of input samples
+ * @param out  [OUT] The block of output samples
  */
-void algo_white(uint16_t *in_buff, uint8_t *out_buff, uint16_t in_pos, uint16_t out_pos, int multisamples); 
+void algo_white(void *ctx, const fad_span_t *in, const fad_span_t *out);
 
 /**
  * @brief Initialize white-noise algorithm
- * @param algo_function [out] pointer to algorithm function
+ * @param ctx [OUT] The algo_white_ctx_t of this instance
+ * @param params The params of data to process from the input. Uses algo_white_params.
  */
-void algo_white_init(int algo_size); 
+void algo_white_init(void *ctx, fad_algo_init_params_t *params);
+
+/**
+ * @brief Deinitalize the function. Nothing is allocated, so this is empty.
+ * @param ctx The algo_white_ctx_t of this instance
+ */
+void algo_white_deinit(void *ctx);
+
+#endif
@@ -0,0 +1,106 @@
+/**
+ * algo_wsola.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Time-domain pitch shifter (WSOLA, waveform-similarity overlap-add). The input is stored in a short
+ * ring and read back at the pitch ratio, so the read position drifts away from the write position.
+ * Before it drifts out of range it jumps back by about ALGO_WSOLA_JUMP samples, to the nearby
+ * position whose waveform best matches what it would have read, and the two positions are
+ * crossfaded over ALGO_WSOLA_OVERLAP samples.
+ *
+ * Latency and cost are bounded by the constants below, independent of the input:
+ * - The read position stays within ALGO_WSOLA_MAX_DELAY samples of the input (under 60 ms).
+ * - A jump searches ALGO_WSOLA_SEARCH samples either side of the nominal jump: every fourth lag over
+ *   every fourth sample first, then every lag near the best over every sample. That is at most
+ *   ALGO_WSOLA_SEARCH_MACS multiply-accumulates.
+ * - A jump starts at most once per ALGO_WSOLA_OVERLAP output samples, since one crossfade must end
+ *   before the next can start, so a 512-sample block searches at most 4 times.
+ */
+
+#ifndef _ALGO_WSOLA_H_
+#define _ALGO_WSOLA_H_
+
+#include <stdint.h>
+#include "fad_defs.h"
+
+/* Samples in the input ring. A power of two, and more than ALGO_WSOLA_MAX_DELAY + 1 */
+#define ALGO_WSOLA_BUFFER_LEN 1024
+
+/* Samples crossfaded at each jump (11.6 ms at OUTPUT_FREQ). Also the length of the compared waveforms */
+#define ALGO_WSOLA_OVERLAP 128
+
+/* Nominal jump, in samples (23 ms at OUTPUT_FREQ). Longer jumps splice less often but repeat or drop more */
+#define ALGO_WSOLA_JUMP 256
+
+/* Farthest the jump may move from nominal, either way. Covers one period of a 86 Hz voice */
+#define ALGO_WSOLA_SEARCH 64
+
+/* Step between lags and between samples in the coarse pass of the search */
+#define ALGO_WSOLA_DECIMATE 4
+
+/* Pitch ratios allowed, Q16: one octave either way */
+#define ALGO_WSOLA_RATIO_MIN 0x8000
+#define ALGO_WSOLA_RATIO_MAX 0x20000
+
+/*
+ * Read positions, as delays behind the input. Raising the pitch, the delay shrinks until it is below
+ * ALGO_WSOLA_LOW_DELAY, leaving the compared waveform and a crossfade at twice the speed written.
+ * Lowering it, the delay grows until it is above ALGO_WSOLA_HIGH_DELAY, leaving room to jump the
+ * farthest forward and still compare a whole waveform.
+ */
+#define ALGO_WSOLA_LOW_DELAY (2 * ALGO_WSOLA_OVERLAP + 2)
+#define ALGO_WSOLA_HIGH_DELAY (ALGO_WSOLA_JUMP + ALGO_WSOLA_SEARCH + ALGO_WSOLA_OVERLAP + 2)
+#define ALGO_WSOLA_START_DELAY (ALGO_WSOLA_LOW_DELAY + ALGO_WSOLA_JUMP / 2)
+
+/* Longest delay either read position reaches, in samples */
+#define ALGO_WSOLA_MAX_DELAY (ALGO_WSOLA_LOW_DELAY + ALGO_WSOLA_JUMP + ALGO_WSOLA_SEARCH + 1)
+
+/* Most multiply-accumulates one search takes: the coarse pass, then the fine pass, each summing the correlation and the energy */
+#define ALGO_WSOLA_SEARCH_MACS (2 * ((2 * ALGO_WSOLA_SEARCH / ALGO_WSOLA_DECIMATE + 1) * (ALGO_WSOLA_OVERLAP / ALGO_WSOLA_DECIMATE) + \
+                                     (2 * ALGO_WSOLA_DECIMATE - 1) * ALGO_WSOLA_OVERLAP))
+
+/* Instance state */
+typedef struct {
+    int32_t ratio;          // Pitch ratio, Q16
+    int32_t drift;          // Change of each read delay per output sample, Q16: 1 - ratio
+    int32_t delay;          // Delay of the read position, Q16
+    int32_t next_delay;     // Delay of the position being faded to, Q16
+    int fade_pos;           // Samples of the crossfade done, or -1 if not fading
+    uint32_t write_pos;     // Ring position of the next sample written. Wraps with the ring
+    fad_q15_t ring[ALGO_WSOLA_BUFFER_LEN];  // Input history, inline
+} algo_wsola_ctx_t;
+
+/* Bytes of state held by the algorithm */
+#define ALGO_WSOLA_STATE_SIZE sizeof(algo_wsola_ctx_t)
+
+/**
+ * @brief WSOLA pitch shift algorithm for ESP masker
+ * @param ctx The algo_wsola_ctx_t of this instance
+ * @param in The block of input samples
+ * @param out [OUT] The block of output samples
+ */
+void algo_wsola(void *ctx, const fad_span_t *in, const fad_span_t *out);
+
+/**
+ * @brief Initializes algorithm constants
+ * @param ctx [OUT] The algo_wsola_ctx_t of this instance
+ * @param params The params of data to process from the input. Uses algo_wsola_params.
+ */
+void algo_wsola_init(void *ctx, fad_algo_init_params_t *params);
+
+/**
+ * @brief Apply another mode's pitch ratio to a running instance. The ring and read position carry over.
+ * @param ctx The algo_wsola_ctx_t of this instance
+ * @param params The params of the new mode. Uses algo_wsola_params.
+ */
+void algo_wsola_update(void *ctx, fad_algo_init_params_t *params);
+
+/**
+ * @brief Deinitalize the function
+ * @param ctx The algo_wsola_ctx_t of this instance
+ */
+void algo_wsola_deinit(void *ctx);
+
+#endif
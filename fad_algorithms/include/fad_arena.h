@@ -0,0 +1,63 @@
+/**
+ * fad_arena.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Bump allocator over a fixed buffer. Algorithm state is carved from an arena reserved at boot
+ * instead of the heap, so switching algorithms never fragments the heap and cannot fail after a
+ * long uptime. Allocations are never freed one at a time: fad_arena_reset releases all of them at once.
+ */
+
+#ifndef _FAD_ARENA_H_
+#define _FAD_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Alignment of every allocation, enough for any type the algorithms hold */
+#define FAD_ARENA_ALIGN 8
+
+/* Round a size up to the arena alignment */
+#define FAD_ARENA_ROUND(size) (((size) + FAD_ARENA_ALIGN - 1) & ~(size_t)(FAD_ARENA_ALIGN - 1))
+
+typedef struct {
+    uint8_t *base;  // Start of the buffer, aligned to FAD_ARENA_ALIGN
+    size_t size;    // Usable bytes in the buffer
+    size_t used;    // Bytes handed out since the last reset
+} fad_arena_t;
+
+/**
+ * @brief Prepare an empty arena over a buffer. Does not allocate.
+ * @param arena [OUT] The arena
+ * @param buff The buffer. Should be aligned to FAD_ARENA_ALIGN; bytes before the first aligned address are skipped
+ * @param size Number of bytes in buff
+ */
+void fad_arena_init(fad_arena_t *arena, void *buff, size_t size);
+
+/**
+ * @brief Take a zeroed block from the arena
+ * @param arena The arena
+ * @param size Number of bytes
+ * @return The block, aligned to FAD_ARENA_ALIGN, or NULL if the arena does not have size bytes left
+ */
+void *fad_arena_alloc(fad_arena_t *arena, size_t size);
+
+/**
+ * @brief Release every block taken from the arena
+ * @param arena The arena
+ */
+static inline void fad_arena_reset(fad_arena_t *arena)
+{
+    arena->used = 0;
+}
+
+/**
+ * @brief Bytes still available
+ */
+static inline size_t fad_arena_remaining(const fad_arena_t *arena)
+{
+    return arena->size - arena->used;
+}
+
+#endif
@@ -0,0 +1,120 @@
+/**
+ * fad_chain.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Runs several algorithms in series on each block. The first stage reads the input block directly,
+ * every stage after it reads the previous stage's output, and the stages alternate between two
+ * scratch buffers that are allocated once by the owner of the chain. The last stage's output is
+ * converted into the DAC block. Stage state is carved from an arena bank that the owner also
+ * reserves once, so building and clearing a chain never touches the heap.
+ *
+ * A chain whose first stages are gated algorithms runs a voice activity detector on each input block.
+ * While it hears no voice, those stages are skipped and their output is filled with silence; the
+ * output ramps over one block, still processed, on the blocks where voice starts and stops.
+ */
+
+#ifndef _FAD_CHAIN_H_
+#define _FAD_CHAIN_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_system.h"
+#include "fad_defs.h"
+#include "fad_span.h"
+#include "algo_registry.h"
+#include "fad_arena.h"
+#include "fad_vad.h"
+
+/* One algorithm instance in a chain */
+typedef struct {
+    const fad_algo_desc_t *desc;    // The algorithm
+    void *ctx;                      // Its state block, desc->state_size bytes
+} fad_chain_stage_t;
+
+/* An algorithm chain */
+typedef struct {
+    fad_chain_stage_t stages[FAD_ALGO_MAX_STAGES];
+    int num_stages;
+    int read_size;          // ADC values per block. The smallest preferred read size of the stages
+    fad_q15_t *scratch[2];  // Ping-pong buffers, each scratch_len samples
+    int scratch_len;
+    fad_span_t scratch_span[2]; // Spans over the scratch buffers for the current block
+    fad_arena_t arena;      // Holds the state of every stage
+    fad_vad_t vad;          // Hears voice in the input block
+    int num_gated;          // Leading stages that only run while vad hears voice. Stages after the first ungated one see a changed signal, so are never gated
+    bool gate_open;         // vad heard voice in the last block
+} fad_chain_t;
+
+/**
+ * @brief Prepare an empty chain. Does not allocate.
+ * @param chain [OUT] The chain
+ * @param scratch_a First scratch buffer
+ * @param scratch_b Second scratch buffer
+ * @param scratch_len Number of samples in each scratch buffer. Bounds the block size
+ * @param bank Memory for stage state. FAD_ALGO_BANK_SIZE bytes holds any registry entry
+ * @param bank_size Number of bytes in bank
+ */
+void fad_chain_init(fad_chain_t *chain, fad_q15_t *scratch_a, fad_q15_t *scratch_b, int scratch_len, void *bank, size_t bank_size);
+
+/**
+ * @brief Add the stages for an algorithm type to the end of the chain. Chain entries in the registry
+ * add each of their stages. Takes the state of each new stage from the chain's bank and initializes it.
+ * @param chain The chain
+ * @param type The algorithm type
+ * @param mode The algorithm mode
+ * @return
+ *      -ESP_OK if successful
+ *      -ESP_ERR_INVALID_ARG if type is unknown
+ *      -ESP_ERR_INVALID_SIZE if the chain would have too many stages
+ *      -ESP_ERR_NO_MEM if the bank has no room for the stage state
+ */
+esp_err_t fad_chain_add(fad_chain_t *chain, fad_algo_type_t type, fad_algo_mode_t mode);
+
+/**
+ * @brief Retune the stages of a chain built for an algorithm type to another mode, in place. Each stage's
+ * update function applies the new mode's params; state such as delay buffers is kept.
+ * @param chain The chain
+ * @param type The algorithm type the chain was built with
+ * @param mode The new algorithm mode
+ * @return
+ *      -ESP_OK if successful
+ *      -ESP_ERR_INVALID_ARG if type is unknown
+ *      -ESP_ERR_INVALID_STATE if the chain does not hold exactly the stages of type
+ *      -ESP_ERR_NOT_SUPPORTED if a stage has no update function. Nothing is changed; rebuild the chain instead
+ */
+esp_err_t fad_chain_update(fad_chain_t *chain, fad_algo_type_t type, fad_algo_mode_t mode);
+
+/**
+ * @brief Deinitialize every stage and release their state. The chain is empty afterwards.
+ * @param chain The chain
+ */
+void fad_chain_clear(fad_chain_t *chain);
+
+/**
+ * @brief Whether the chain heard voice in the last block it ran, or still holds it. Always true for a chain with no gated stages
+ * @param chain The chain
+ */
+static inline bool fad_chain_voice_active(const fad_chain_t *chain)
+{
+    return chain->num_gated == 0 || chain->gate_open;
+}
+
+/**
+ * @brief Run every stage on one block, leaving the result as Q15 samples
+ * @param chain The chain
+ * @param in The block of input samples. No longer than the scratch buffers
+ * @return The last stage's output, valid until the scratch buffers are next written. in itself if the chain is empty
+ */
+const fad_span_t *fad_chain_run(fad_chain_t *chain, const fad_span_t *in);
+
+/**
+ * @brief Run every stage on one block and convert the result to DAC values. An empty chain outputs the input unchanged.
+ * @param chain The chain
+ * @param in The block of input samples. No longer than the scratch buffers
+ * @param out [OUT] The block of DAC values. Same length as in
+ */
+void fad_chain_process(fad_chain_t *chain, const fad_span_t *in, const fad_dac_span_t *out);
+
+#endif
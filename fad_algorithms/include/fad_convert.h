@@ -0,0 +1,166 @@
+/**
+ * fad_convert.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Conversions between the sample formats of the project:
+ *  - ADC:    uint16_t, 12-bit unsigned, centered on 2048. What the ADC produces.
+ *  - Q15:    fad_q15_t, signed, centered on 0. The working format of every algorithm.
+ *  - DAC:    uint8_t, 8-bit unsigned, centered on 128. What the DAC outputs.
+ *  - Stereo: int16_t pairs, left then right. What A2DP sends.
+ *  - Packed: 12-bit signed samples, two in every 3 bytes (low sample first, little-endian bit order).
+ *            Keeps the full ADC resolution in 75% of the space of Q15. Used for delay lines.
+ *
+ * The block kernels handle 4 samples per iteration using 32-bit words, peeling samples at the
+ * start until the buffers are word aligned. A Q15 buffer that cannot be aligned together with the
+ * 8-bit side is accessed 16 bits at a time. Every format maps onto the full range
+ * of the next, so no conversion can overflow; ADC values are masked to 12 bits.
+ *
+ * The ADC -> Q15 conversion only removes the nominal midscale offset. A microphone bias off midscale
+ * is removed afterwards by one DC blocker (fad_dc_block) shared by every algorithm, which the app runs
+ * on each converted block.
+ *
+ * ADC -> Q15 -> DAC is exact: the DAC value is the top 8 bits of the ADC value, as before.
+ * ADC -> Q15 -> Packed -> Q15 is lossless; other Q15 samples lose their bottom 4 bits when packed.
+ */
+
+#ifndef _FAD_CONVERT_H_
+#define _FAD_CONVERT_H_
+
+#include <stdint.h>
+#include "fad_fixed.h"
+
+/* ADC value of a silent input */
+#define FAD_ADC_MIDSCALE 2048
+
+/* DC blocker pole, Q30 (0.995: corner near 9 Hz at 11025 Hz) */
+#define FAD_DC_BLOCK_POLE 1068373606
+
+/* Extra fractional bits of the DC blocker's output state */
+#define FAD_DC_BLOCK_GUARD 8
+
+/* A one-pole DC blocker, y[n] = x[n] - x[n-1] + FAD_DC_BLOCK_POLE * y[n-1] */
+typedef struct {
+    int32_t x1;         // Last input, with FAD_DC_BLOCK_GUARD extra fractional bits
+    int32_t y1;         // Last output, with FAD_DC_BLOCK_GUARD extra fractional bits
+} fad_dc_block_t;
+
+/**
+ * @brief Convert one 12-bit ADC value to Q15, removing the midscale offset
+ */
+static inline fad_q15_t fad_adc_to_q15(uint16_t adc)
+{
+    return (fad_q15_t)(((adc & 0x0FFF) << 4) ^ 0x8000);
+}
+
+/**
+ * @brief Convert one Q15 sample to an 8-bit DAC value (top 8 bits, offset to midscale)
+ */
+static inline uint8_t fad_q15_to_dac(fad_q15_t q)
+{
+    return (uint8_t)(((uint16_t)q ^ 0x8000) >> 8);
+}
+
+/**
+ * @brief Convert one 8-bit DAC value to Q15
+ */
+static inline fad_q15_t fad_dac_to_q15(uint8_t dac)
+{
+    return (fad_q15_t)((dac ^ 0x80) << 8);
+}
+
+/**
+ * @brief Store one Q15 sample at a position of a packed 12-bit buffer, keeping its neighbour
+ */
+static inline void fad_packed12_set(uint8_t *buff, int pos, fad_q15_t q)
+{
+    uint8_t *p = buff + 3 * (pos >> 1);
+    uint16_t v = (uint16_t)q >> 4;
+    if (pos & 1)
+    {
+        p[1] = (uint8_t)((p[1] & 0x0F) | (v << 4));
+        p[2] = (uint8_t)(v >> 4);
+    }
+    else
+    {
+        p[0] = (uint8_t)v;
+        p[1] = (uint8_t)((p[1] & 0xF0) | (v >> 8));
+    }
+}
+
+/**
+ * @brief Read one Q15 sample from a position of a packed 12-bit buffer
+ */
+static inline fad_q15_t fad_packed12_get(const uint8_t *buff, int pos)
+{
+    const uint8_t *p = buff + 3 * (pos >> 1);
+    uint16_t v = (pos & 1) ? (uint16_t)((p[1] >> 4) | (p[2] << 4)) : (uint16_t)(p[0] | ((p[1] & 0x0F) << 8));
+    return (fad_q15_t)(v << 4);
+}
+
+/**
+ * @brief Convert len ADC values to Q15. in and out may be the same buffer.
+ * @param in The ADC values
+ * @param out [OUT] The samples
+ * @param len Number of values
+ */
+void fad_convert_adc_to_q15(const uint16_t *in, fad_q15_t *out, int len);
+
+/**
+ * @brief Reset a DC blocker to a silent input
+ * @param dc [OUT] The blocker
+ */
+void fad_dc_block_init(fad_dc_block_t *dc);
+
+/**
+ * @brief Remove the DC from a block of samples, in place. Keep one blocker per input stream
+ * @param dc The blocker
+ * @param buff The samples
+ * @param len Number of samples
+ */
+void fad_dc_block(fad_dc_block_t *dc, fad_q15_t *buff, int len);
+
+/**
+ * @brief Convert len Q15 samples to DAC values
+ * @param in The samples
+ * @param out [OUT] The DAC values
+ * @param len Number of samples
+ */
+void fad_convert_q15_to_dac(const fad_q15_t *in, uint8_t *out, int len);
+
+/**
+ * @brief Convert len DAC values to Q15
+ * @param in The DAC values
+ * @param out [OUT] The samples
+ * @param len Number of values
+ */
+void fad_convert_dac_to_q15(const uint8_t *in, fad_q15_t *out, int len);
+
+/**
+ * @brief Expand len DAC values to interleaved 16-bit stereo, writing each value repeat times
+ * (both channels equal). Used to raise the output rate for A2DP.
+ * @param in The DAC values
+ * @param out [OUT] The stereo frames, 2 * repeat * len values
+ * @param len Number of DAC values
+ * @param repeat Number of frames per value. At least 1
+ */
+void fad_convert_dac_to_stereo(const uint8_t *in, int16_t *out, int len, int repeat);
+
+/**
+ * @brief Pack pairs of Q15 samples into 12-bit values, 3 bytes per pair
+ * @param in The samples, 2 * pairs of them
+ * @param out [OUT] The packed values, 3 * pairs bytes
+ * @param pairs Number of sample pairs
+ */
+void fad_convert_q15_to_packed12(const fad_q15_t *in, uint8_t *out, int pairs);
+
+/**
+ * @brief Unpack pairs of 12-bit values to Q15 samples
+ * @param in The packed values, 3 * pairs bytes
+ * @param out [OUT] The samples, 2 * pairs of them
+ * @param pairs Number of sample pairs
+ */
+void fad_convert_packed12_to_q15(const uint8_t *in, fad_q15_t *out, int pairs);
+
+#endif
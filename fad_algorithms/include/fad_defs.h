@@ -11,12 +11,15 @@
 
 #include <stdlib.h>
 #include "esp_system.h"
+#include "fad_span.h"
+#include "fad_delay_line.h"
 
 /* ADC Definitions */
 #define ADC_BUFFER_SIZE 2048    //Buffer size for holding ADC data. 
-#define MULTISAMPLES 1          //Number of ADC samples per DAC output
+#define MULTISAMPLES 1          //Number of ADC samples per DAC output. Averaged with a kernel specialized for this factor
 #define DAC_BUFFER_SIZE (ADC_BUFFER_SIZE / MULTISAMPLES)  //Buffer size for holding staged DAC data. Hold one DAC sample for each ADC sample divided by multisamples
 #define ADC_CHANNEL ADC_CHANNEL_6
+#define FAD_BLOCK_SIZE 512      //ADC values per algorithm call. The same for every algorithm, so swapping algorithms never changes how often the timer notifies
 
 /* Timer Definitions */
 #define TIMER_FREQ 88200    //Frequency of the Timer
@@ -56,6 +59,14 @@ typedef enum {
     FAD_ALGO_MASKING,
     FAD_ALGO_TEMPLATE,
     FAD_ALGO_WHITE,
+    FAD_ALGO_GAIN,
+    FAD_ALGO_DELAY_FREQ_SHIFT,  // Chain: FAD_ALGO_DELAY then FAD_ALGO_FREQ_SHIFT (combined DAF + FAF)
+    FAD_ALGO_DELAY_LONG,        // FAD_ALGO_DELAY with ADPCM storage, for delays past one second
+    FAD_ALGO_DELAY_12BIT,       // FAD_ALGO_DELAY with packed 12-bit storage, keeping the full ADC resolution
+    FAD_ALGO_MULTITAP,
+    FAD_ALGO_WSOLA,
+    FAD_ALGO_VOCODER,
+    FAD_ALGO_COUNT,     // Number of algorithms. Must stay last.
 } fad_algo_type_t;
 
 /* These modes dictate param choices for each function. Higher modes mean greater algo effects */
@@ -63,14 +74,32 @@ typedef enum {
     FAD_ALGO_MODE_1,
     FAD_ALGO_MODE_2,
     FAD_ALGO_MODE_3,
+    FAD_ALGO_MODE_COUNT,    // Number of modes. Must stay last.
 } fad_algo_mode_t;
 
+/* Most taps a FAD_ALGO_MULTITAP mode may use */
+#define ALGO_MULTITAP_MAX_TAPS 4
+
+/* Pitch estimators FAD_ALGO_MASKING can follow (fad_pitch.h). Designated initializers that leave it out get FAD_PITCH_YIN */
+typedef enum {
+    FAD_PITCH_YIN,      // Time domain, every block, fixed point
+    FAD_PITCH_HPS,      // Harmonic product spectrum, every pitch_interval blocks. More robust to noise
+} fad_pitch_source_t;
+
+/* Masker waveforms of FAD_ALGO_MASKING (fad_nco.h). Designated initializers that leave it out get FAD_MASKER_SAW */
+typedef enum {
+    FAD_MASKER_SAW,         // Band-limited sawtooth: every harmonic, falling 6 dB per octave
+    FAD_MASKER_TRIANGLE,    // Band-limited triangle: odd harmonics, falling 12 dB per octave. Softer
+} fad_masker_wave_t;
+
 /* The parameters to be passed to an algorithm initialization function */
 typedef union {
     /* FAD_ALGO_DELAY */
     struct algo_delay_params_t {
         int read_size;
-        int delay;
+        int delay_ms;       // Delay in milliseconds, kept exact at any OUTPUT_FREQ. Can be changed while running (algo_delay_set_delay_ms)
+        fad_delay_line_format_t storage;    // Delay line storage. ADPCM holds about twice the delay of 8-bit in the same memory, PACKED12 two thirds
+        fad_delay_interp_t interp;          // Interpolation for delays between samples
     } algo_delay_params;
 
     /* FAD_ALGO_TEMPLATE */
@@ -88,22 +117,57 @@ typedef union {
     /* FAD_ALGO_MASKING */
     struct algo_masking_params_t {
         int read_size;      // Number of reads from ADC per algo call
+        fad_pitch_source_t pitch;   // Pitch estimator followed
+        int pitch_interval;         // Blocks per estimate, for FAD_PITCH_HPS. 0 is taken as 1
+        fad_masker_wave_t wave;     // Waveform of the masker
     } algo_masking_params;
 
+    /* FAD_ALGO_WHITE */
+    struct algo_white_params_t {
+        int read_size;      // Number of reads from ADC per algo call
+    } algo_white_params;
+
+    /* FAD_ALGO_MULTITAP */
+    struct algo_multitap_params_t {
+        int read_size;      // Number of reads from ADC per algo call
+        int num_taps;       // Number of taps used, up to ALGO_MULTITAP_MAX_TAPS
+        int tap_ms[ALGO_MULTITAP_MAX_TAPS];     // Delay of each tap in milliseconds
+        int tap_gain[ALGO_MULTITAP_MAX_TAPS];   // Gain of each tap in percent (100 = unity)
+        fad_delay_line_format_t storage;    // Delay line storage
+    } algo_multitap_params;
+
+    /* FAD_ALGO_WSOLA */
+    struct algo_wsola_params_t {
+        int read_size;      // Number of reads from ADC per algo call
+        int cents;          // Pitch shift in cents (100 = one semitone), up to an octave either way
+    } algo_wsola_params;
+
+    /* FAD_ALGO_VOCODER */
+    struct algo_vocoder_params_t {
+        int read_size;      // Number of reads from ADC per algo call
+        int cents;          // Pitch shift in cents (100 = one semitone)
+        int frame_size;     // Samples per analysis frame. A power of two, up to ALGO_VOCODER_MAX_FRAME
+        int hop;            // Samples between frames, at most frame_size / 4. Latency is frame_size
+    } algo_vocoder_params;
+
+    /* FAD_ALGO_GAIN */
+    struct algo_gain_params_t {
+        int read_size;      // Number of reads from ADC per algo call
+        int gain;           // Gain in percent (100 = unity)
+    } algo_gain_params;
+
 } fad_algo_init_params_t;
 
 
 /*
- * Global variables
+ * Global variables. Defined by the application (fad_adc.c), not by the algorithms.
  */
-char *ALGO_TAG;
-
-uint16_t *adc_buffer;
-uint8_t *dac_buffer;
-uint16_t adc_buffer_pos;
-uint16_t dac_buffer_pos;
-uint16_t adc_buffer_pos_copy;
-uint16_t dac_buffer_pos_copy;
+extern uint16_t *adc_buffer;
+extern uint8_t *dac_buffer;
+extern uint16_t adc_buffer_pos;
+extern uint16_t dac_buffer_pos;
+extern uint16_t adc_buffer_pos_copy;
+extern uint16_t dac_buffer_pos_copy;
 
 /*
 * Function typedefs
@@ -112,17 +176,36 @@ uint16_t dac_buffer_pos_copy;
 /**
  * @brief     algorithm function
  * 
- * @param in_buff Pointer to beginning of ADC buffer (also a global)
- * @param out_buff [OUT] Pointer to beginning of DAC buffer (also a global)
- * @param in_pos Integer index of algorithm beginning location in ADC buffer
- * @param out_pos Integer index of algorithm beginning location in ADC buffer
- * @param multisamples The number of input samples per output
+ * @param ctx Pointer to the algorithm instance's state block, previously passed to its init function
+ * @param in The block of Q15 samples to read. Same length as out; one input value per output value
+ * @param out [OUT] The block of Q15 samples to write. Write every value, and nothing outside the span.
+ *            Input and output share a format, so algorithms can be chained.
  */
-typedef void (* algo_func_t) (uint16_t *in_buff, uint8_t *out_buff, uint16_t in_pos, uint16_t out_pos, int multisamples);
+typedef void (* algo_func_t) (void *ctx, const fad_span_t *in, const fad_span_t *out);
 
-typedef void (* algo_init_func_t) (fad_algo_init_params_t *params);
+/**
+ * @brief     algorithm initialization function
+ *
+ * @param ctx [OUT] Caller-owned state block of the algorithm's state size. All instance state lives here.
+ * @param params The params for this instance
+ */
+typedef void (* algo_init_func_t) (void *ctx, fad_algo_init_params_t *params);
 
-typedef void (* algo_deinit_func_t) ();
+/**
+ * @brief     algorithm update function. Applies another mode's params to a running instance without
+ *            reinitializing it, between calls to the algorithm function.
+ *
+ * @param ctx The state block passed to init
+ * @param params The params for the new mode
+ */
+typedef void (* algo_update_func_t) (void *ctx, fad_algo_init_params_t *params);
+
+/**
+ * @brief     algorithm deinitialization function. The caller releases ctx afterwards; free anything else the algorithm allocated.
+ *
+ * @param ctx The state block passed to init
+ */
+typedef void (* algo_deinit_func_t) (void *ctx);
 
 /**
  * @brief     callback function for app events
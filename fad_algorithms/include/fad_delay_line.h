@@ -0,0 +1,139 @@
+/**
+ * fad_delay_line.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * A circular line of past Q15 samples over a caller-owned byte buffer, in one of several storage
+ * formats. The format trades resolution for length: the same buffer holds twice as many samples
+ * as IMA-ADPCM as it does as 8-bit DAC values, and two thirds as many at the full 12-bit ADC resolution. Samples are addressed by how far they lie behind
+ * the write position, so a reader never needs to know the format.
+ *
+ * Delays between samples are read with fixed-point interpolation from a Q16 delay, so a delay in ms
+ * is kept exactly rather than rounded to the sample rate, and a moving delay glides without steps.
+ *
+ * IMA-ADPCM is stored in chunks of FAD_DELAY_LINE_CHUNK samples, each starting with the encoder
+ * state, so any chunk can be decoded on its own. Reads decode a whole chunk at a time into a small
+ * cache; consecutive reads, and the pair of neighbours an interpolating reader takes, hit the cache.
+ */
+
+#ifndef _FAD_DELAY_LINE_H_
+#define _FAD_DELAY_LINE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "fad_fixed.h"
+
+/* How samples are stored. Designated initializers that leave it out get FAD_DELAY_LINE_U8 */
+typedef enum {
+    FAD_DELAY_LINE_U8,      // 8-bit DAC values. 1 byte per sample
+    FAD_DELAY_LINE_ADPCM,   // IMA-ADPCM. 4 bits per sample plus a 4 byte header per chunk
+    FAD_DELAY_LINE_PACKED12,    // 12-bit samples, 3 bytes per 2 samples. Lossless for ADC input
+} fad_delay_line_format_t;
+
+/* How values between samples are interpolated. Designated initializers that leave it out get FAD_DELAY_INTERP_LINEAR */
+typedef enum {
+    FAD_DELAY_INTERP_LINEAR,    // 2 points. Cheapest; dulls high frequencies at fractional delays
+    FAD_DELAY_INTERP_LAGRANGE,  // 4 points, third-order Lagrange evaluated in Farrow form. Flatter response up to about a quarter of the rate
+} fad_delay_interp_t;
+
+/* Samples per ADPCM chunk */
+#define FAD_DELAY_LINE_CHUNK 64
+
+/* Bytes per ADPCM chunk: predictor (int16), step index (uint8), padding, then one nibble per sample */
+#define FAD_DELAY_LINE_CHUNK_BYTES (4 + FAD_DELAY_LINE_CHUNK / 2)
+
+/* One decoded ADPCM chunk */
+typedef struct {
+    int chunk;              // Chunk index, or -1 if empty
+    int valid;              // Samples decoded from the start of the chunk
+    fad_q15_t samples[FAD_DELAY_LINE_CHUNK];
+} fad_delay_line_cache_t;
+
+/* A delay line */
+typedef struct {
+    fad_delay_line_format_t format;
+    uint8_t *buff;          // Storage
+    int length;             // Samples in the ring
+    int max_delay;          // Longest delay that can be read. Less than length for ADPCM, whose oldest chunk is overwritten as a whole
+    int write_pos;          // Ring position of the next sample written
+
+    /* ADPCM only */
+    int32_t predictor;      // Encoder state: the last sample as the decoder will see it
+    int step_index;         // Encoder state: index into the step table
+    fad_delay_line_cache_t cache[2];    // Decoded chunks, by chunk parity
+} fad_delay_line_t;
+
+/**
+ * @brief Convert a delay in milliseconds to samples at a sample rate, Q16. Kept to 1/65536 of a sample rather than rounded.
+ * @param delay_ms The delay in milliseconds
+ * @param rate The sample rate in Hz
+ */
+static inline int32_t fad_delay_line_ms(int delay_ms, int rate)
+{
+    return (int32_t)((((int64_t)delay_ms * rate << 16) + 500) / 1000);
+}
+
+/**
+ * @brief Prepare a silent delay line over a buffer. Does not allocate.
+ * @param line [OUT] The delay line
+ * @param format The storage format
+ * @param buff The storage
+ * @param size Number of bytes in buff
+ */
+void fad_delay_line_init(fad_delay_line_t *line, fad_delay_line_format_t format, uint8_t *buff, size_t size);
+
+/**
+ * @brief Store samples at the write position and advance it
+ * @param line The delay line
+ * @param in The samples
+ * @param len Number of samples
+ */
+void fad_delay_line_write(fad_delay_line_t *line, const fad_q15_t *in, int len);
+
+/**
+ * @brief Read consecutive samples, oldest first, starting delay samples behind the write position
+ * @param line The delay line
+ * @param delay How far behind the write position the first sample lies. 1 .. max_delay
+ * @param out [OUT] The samples
+ * @param len Number of samples. No more than delay, so every sample was written before the call
+ */
+void fad_delay_line_read(fad_delay_line_t *line, int delay, fad_q15_t *out, int len);
+
+/**
+ * @brief Read one sample
+ * @param line The delay line
+ * @param delay How far behind the write position the sample lies. 1 .. max_delay
+ * @return The sample
+ */
+fad_q15_t fad_delay_line_tap(fad_delay_line_t *line, int delay);
+
+/**
+ * @brief Limit a fractional delay to what fad_delay_line_read_frac can read: whole delays 1 .. max_delay,
+ * and delays between samples 2 .. max_delay - 2, leaving room for the interpolation points
+ * @param line The delay line
+ * @param delay The delay in samples, Q16
+ * @return The delay in range, Q16
+ */
+int32_t fad_delay_line_clamp(const fad_delay_line_t *line, int32_t delay);
+
+/**
+ * @brief Read consecutive samples at a fractional delay, oldest first
+ * @param line The delay line
+ * @param delay How far behind the write position the first sample lies, Q16. Within fad_delay_line_clamp
+ * @param out [OUT] The samples
+ * @param len Number of samples. No more than the whole part of delay, less one if delay is not whole
+ * @param interp The interpolation between samples
+ */
+void fad_delay_line_read_frac(fad_delay_line_t *line, int32_t delay, fad_q15_t *out, int len, fad_delay_interp_t interp);
+
+/**
+ * @brief Read one sample at a fractional delay. Any delay is accepted: points outside the line repeat the sample at its edge
+ * @param line The delay line
+ * @param delay How far behind the write position the sample lies, Q16
+ * @param interp The interpolation between samples
+ * @return The sample
+ */
+fad_q15_t fad_delay_line_tap_frac(fad_delay_line_t *line, int32_t delay, fad_delay_interp_t interp);
+
+#endif
@@ -0,0 +1,191 @@
+/**
+ * fad_fixed.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Fixed-point arithmetic for the algorithms. Q15 values are int16_t in [-1, 1), Q31 values are
+ * int32_t in [-1, 1). Every operation that can overflow saturates instead of wrapping.
+ * The scalar primitives are inline so they can be used in per-sample loops; the block kernels
+ * are in fad_fixed.c.
+ */
+
+#ifndef _FAD_FIXED_H_
+#define _FAD_FIXED_H_
+
+#include <stdint.h>
+
+typedef int16_t fad_q15_t;
+typedef int32_t fad_q31_t;
+
+#define FAD_Q15_ONE 0x7FFF          // Largest Q15 value, just under 1.0
+#define FAD_Q15_MIN (-0x8000)
+#define FAD_Q31_ONE 0x7FFFFFFF      // Largest Q31 value, just under 1.0
+#define FAD_Q31_MIN (-0x7FFFFFFF - 1)
+
+/* Convert a constant to Q15 / Q31 at compile time. x must be in [-1, 1) */
+#define FAD_Q15(x) ((fad_q15_t)((x) * 32768.0 + ((x) >= 0 ? 0.5 : -0.5)))
+#define FAD_Q31(x) ((fad_q31_t)((x) * 2147483648.0 + ((x) >= 0 ? 0.5 : -0.5)))
+
+/**
+ * @brief Saturate a 32-bit value to Q15
+ */
+static inline fad_q15_t fad_sat_q15(int32_t x)
+{
+    if (x > FAD_Q15_ONE) return FAD_Q15_ONE;
+    if (x < FAD_Q15_MIN) return FAD_Q15_MIN;
+    return (fad_q15_t)x;
+}
+
+/**
+ * @brief Saturate a 64-bit value to Q31
+ */
+static inline fad_q31_t fad_sat_q31(int64_t x)
+{
+    if (x > FAD_Q31_ONE) return FAD_Q31_ONE;
+    if (x < FAD_Q31_MIN) return FAD_Q31_MIN;
+    return (fad_q31_t)x;
+}
+
+/**
+ * @brief Arithmetic right shift with round-half-up. shift must be at least 1
+ */
+static inline int32_t fad_rshift_round(int32_t x, int shift)
+{
+    return (x + (1 << (shift - 1))) >> shift;
+}
+
+/**
+ * @brief Arithmetic right shift with round-half-up, 64-bit. shift must be at least 1
+ */
+static inline int64_t fad_rshift_round64(int64_t x, int shift)
+{
+    return (x + ((int64_t)1 << (shift - 1))) >> shift;
+}
+
+/**
+ * @brief Saturating Q15 addition
+ */
+static inline fad_q15_t fad_add_q15(fad_q15_t a, fad_q15_t b)
+{
+    return fad_sat_q15((int32_t)a + b);
+}
+
+/**
+ * @brief Rounded, saturating Q15 multiply. Only -1 * -1 saturates
+ */
+static inline fad_q15_t fad_mul_q15(fad_q15_t a, fad_q15_t b)
+{
+    return fad_sat_q15(fad_rshift_round((int32_t)a * b, 15));
+}
+
+/**
+ * @brief Q15 multiply-accumulate into a Q30 accumulator. Saturates the accumulator.
+ * Convert the result back with fad_sat_q15(fad_rshift_round(acc, 15)).
+ */
+static inline int32_t fad_mac_q15(int32_t acc, fad_q15_t a, fad_q15_t b)
+{
+    int64_t sum = (int64_t)acc + (int32_t)a * b;
+    if (sum > INT32_MAX) return INT32_MAX;
+    if (sum < INT32_MIN) return INT32_MIN;
+    return (int32_t)sum;
+}
+
+/**
+ * @brief Saturating Q31 addition
+ */
+static inline fad_q31_t fad_add_q31(fad_q31_t a, fad_q31_t b)
+{
+    return fad_sat_q31((int64_t)a + b);
+}
+
+/**
+ * @brief Rounded, saturating Q31 multiply
+ */
+static inline fad_q31_t fad_mul_q31(fad_q31_t a, fad_q31_t b)
+{
+    return fad_sat_q31(fad_rshift_round64((int64_t)a * b, 31));
+}
+
+/**
+ * @brief Q31 multiply-accumulate into a Q62 accumulator. Convert the result back with
+ * fad_sat_q31(fad_rshift_round64(acc, 31)).
+ */
+static inline int64_t fad_mac_q31(int64_t acc, fad_q31_t a, fad_q31_t b)
+{
+    return acc + (int64_t)a * b;
+}
+
+/**
+ * @brief Multiply a Q31 value by a Q15 value, giving Q31
+ */
+static inline fad_q31_t fad_mul_q31_q15(fad_q31_t a, fad_q15_t b)
+{
+    return fad_sat_q31(fad_rshift_round64((int64_t)a * b, 15));
+}
+
+/**
+ * @brief Number of leading zero bits of a non-zero 32-bit value
+ */
+static inline int fad_clz32(uint32_t x)
+{
+    return __builtin_clz(x);
+}
+
+/**
+ * @brief Approximate reciprocal of a positive integer, without division. Compute it once when
+ * the divisor changes, then divide with fad_mul_recip in the per-sample loop.
+ * @param d The divisor. 0 is taken as 1
+ * @param shift [OUT] The shift to pass to fad_mul_recip. Between 31 and 62
+ * @return Q31 mantissa m in [0.5, 1), so that (x * m) >> shift ~= x / d
+ */
+fad_q31_t fad_recip_u32(uint32_t d, int *shift);
+
+/**
+ * @brief Divide by the result of fad_recip_u32: returns x * m >> shift, rounded
+ */
+static inline int32_t fad_mul_recip(int32_t x, fad_q31_t m, int shift)
+{
+    return (int32_t)fad_rshift_round64((int64_t)x * m, shift);
+}
+
+/*
+ * Block kernels. in and out may be the same buffer.
+ */
+
+/**
+ * @brief out[i] = in[i] * gain * 2^shift, saturated. shift, from 0 to 15, allows gains of 1 or more
+ */
+void fad_gain_q15(const fad_q15_t *in, fad_q15_t *out, int len, fad_q15_t gain, int shift);
+
+/**
+ * @brief out[i] = a[i] * gain_a + b[i] * gain_b, saturated
+ */
+void fad_mix_q15(const fad_q15_t *a, const fad_q15_t *b, fad_q15_t *out, int len, fad_q15_t gain_a, fad_q15_t gain_b);
+
+/**
+ * @brief out[i] = in[i] clipped to [lo, hi]
+ */
+void fad_clip_q15(const fad_q15_t *in, fad_q15_t *out, int len, fad_q15_t lo, fad_q15_t hi);
+
+/**
+ * @brief out[i] = a[i] * b[i], rounded and saturated
+ */
+void fad_mul_block_q15(const fad_q15_t *a, const fad_q15_t *b, fad_q15_t *out, int len);
+
+/**
+ * @brief out[i] = in[i] * gain * 2^shift, saturated. shift, from 0 to 31, allows gains of 1 or more
+ */
+void fad_gain_q31(const fad_q31_t *in, fad_q31_t *out, int len, fad_q31_t gain, int shift);
+
+/**
+ * @brief out[i] = a[i] * gain_a + b[i] * gain_b, saturated
+ */
+void fad_mix_q31(const fad_q31_t *a, const fad_q31_t *b, fad_q31_t *out, int len, fad_q31_t gain_a, fad_q31_t gain_b);
+
+/**
+ * @brief out[i] = in[i] clipped to [lo, hi]
+ */
+void fad_clip_q31(const fad_q31_t *in, fad_q31_t *out, int len, fad_q31_t lo, fad_q31_t hi);
+
+#endif
@@ -0,0 +1,29 @@
+/**
+ * fad_kernels.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Hot inner loops, instantiated at compile time for the block the app actually runs so the loop
+ * counts and divisors are constants. Call the dispatchers below: they pick the instance for len, and
+ * fall back to a generic loop for any other length.
+ */
+
+#ifndef _FAD_KERNELS_H_
+#define _FAD_KERNELS_H_
+
+#include <stdint.h>
+#include "fad_fixed.h"
+
+/**
+ * @brief Average each group of factor consecutive ADC values into one ADC value. Specialized for a whole
+ * FAD_BLOCK_SIZE block at MULTISAMPLES values per sample; the pieces of a block split by the wrap, and
+ * other factors, use the generic loop.
+ * @param in The ADC values, out_len * factor of them
+ * @param out [OUT] The averaged values
+ * @param out_len Number of samples to write
+ * @param factor Number of ADC values per sample
+ */
+void fad_kernel_average(const uint16_t *in, uint16_t *out, int out_len, int factor);
+
+#endif
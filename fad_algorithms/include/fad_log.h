@@ -0,0 +1,103 @@
+/**
+ * fad_log.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Deferred logging for the audio path. FAD_LOGx stores a fixed-size record (level, time, tag and
+ * format pointers, up to FAD_LOG_MAX_ARGS integer arguments) in a lock-free ring and returns; nothing
+ * is formatted or printed. A low-priority task calls fad_log_drain to format the records and pass them
+ * to ESP_LOG. Writing costs a handful of stores and one compare-and-swap, so it is safe once per block
+ * from the audio task. When the ring is full, new records are dropped and counted rather than waited on.
+ *
+ * Records below FAD_LOG_LEVEL compile to nothing, arguments included; only the tag is referenced, so a
+ * tag used by nothing else does not warn. Set the level for the build, e.g. -DFAD_LOG_LEVEL=0
+ * (FAD_LOG_LEVEL_NONE) to remove every record, or 4 (FAD_LOG_LEVEL_DEBUG) for per-block detail.
+ *
+ * Only the pointers are stored, so the tag and format must outlive the record: use string literals or
+ * static strings. Arguments are stored as int32_t, so formats may only use integer conversions (%d,
+ * %u, %x, %c).
+ */
+
+#ifndef _FAD_LOG_H_
+#define _FAD_LOG_H_
+
+#include <stdint.h>
+
+#define FAD_LOG_LEVEL_NONE 0
+#define FAD_LOG_LEVEL_ERROR 1
+#define FAD_LOG_LEVEL_WARN 2
+#define FAD_LOG_LEVEL_INFO 3
+#define FAD_LOG_LEVEL_DEBUG 4
+
+/* Most detailed level compiled in */
+#ifndef FAD_LOG_LEVEL
+#define FAD_LOG_LEVEL FAD_LOG_LEVEL_INFO
+#endif
+
+/* Records the ring holds. A power of two */
+#define FAD_LOG_RING_SIZE 64
+
+/* Most integer arguments a record holds. Further arguments are ignored */
+#define FAD_LOG_MAX_ARGS 4
+
+/* A log record */
+typedef struct {
+    uint32_t seq;           // Ring position the slot is free for, or that position + 1 once written
+    uint32_t time;          // esp_log_timestamp() when written, ms
+    const char *tag;
+    const char *format;
+    int32_t args[FAD_LOG_MAX_ARGS];
+    uint8_t level;          // FAD_LOG_LEVEL_x
+} fad_log_record_t;
+
+/**
+ * @brief Empty the ring. Call once before anything logs; records written before are dropped.
+ */
+void fad_log_init(void);
+
+/**
+ * @brief Store a record. Lock-free and never blocks; use the FAD_LOGx macros instead of calling this
+ * @param level FAD_LOG_LEVEL_x
+ * @param tag Static tag string
+ * @param format Static format string, integer conversions only
+ */
+void fad_log_write(uint8_t level, const char *tag, const char *format, int32_t a0, int32_t a1, int32_t a2, int32_t a3);
+
+/**
+ * @brief Format and print every stored record, oldest first, and report any that were dropped.
+ * Call from one low-priority task only.
+ * @return Number of records printed
+ */
+int fad_log_drain(void);
+
+/* The first FAD_LOG_MAX_ARGS arguments, padded with zeros. The leading 0 keeps the list non-empty */
+#define FAD_LOG_ARGS_(unused, a0, a1, a2, a3, ...) (int32_t)(a0), (int32_t)(a1), (int32_t)(a2), (int32_t)(a3)
+
+#define FAD_LOG_(level, tag, format, ...) fad_log_write(level, tag, format, FAD_LOG_ARGS_(0, ##__VA_ARGS__, 0, 0, 0, 0))
+
+#if FAD_LOG_LEVEL >= FAD_LOG_LEVEL_ERROR
+#define FAD_LOGE(tag, format, ...) FAD_LOG_(FAD_LOG_LEVEL_ERROR, tag, format, ##__VA_ARGS__)
+#else
+#define FAD_LOGE(tag, format, ...) do { (void)(tag); } while (0)
+#endif
+
+#if FAD_LOG_LEVEL >= FAD_LOG_LEVEL_WARN
+#define FAD_LOGW(tag, format, ...) FAD_LOG_(FAD_LOG_LEVEL_WARN, tag, format, ##__VA_ARGS__)
+#else
+#define FAD_LOGW(tag, format, ...) do { (void)(tag); } while (0)
+#endif
+
+#if FAD_LOG_LEVEL >= FAD_LOG_LEVEL_INFO
+#define FAD_LOGI(tag, format, ...) FAD_LOG_(FAD_LOG_LEVEL_INFO, tag, format, ##__VA_ARGS__)
+#else
+#define FAD_LOGI(tag, format, ...) do { (void)(tag); } while (0)
+#endif
+
+#if FAD_LOG_LEVEL >= FAD_LOG_LEVEL_DEBUG
+#define FAD_LOGD(tag, format, ...) FAD_LOG_(FAD_LOG_LEVEL_DEBUG, tag, format, ##__VA_ARGS__)
+#else
+#define FAD_LOGD(tag, format, ...) do { (void)(tag); } while (0)
+#endif
+
+#endif
@@ -0,0 +1,156 @@
+/**
+ * fad_nco.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Numerically controlled oscillator. A 32-bit phase accumulator steps through one cycle per 2^32,
+ * and the top bits of the phase index a quarter-wave Q15 sine table held in flash. Any frequency is
+ * one step value, so changing it rebuilds nothing, and each output costs one table lookup (two with
+ * linear interpolation, which brings the worst-case error from about -44 dB to within 2 LSB).
+ *
+ * The same accumulator drives band-limited sawtooth and triangle waves. The naive waveforms alias
+ * badly, since their corners hold harmonics far past Nyquist; PolyBLEP (for the saw's jump) and
+ * PolyBLAMP (for the triangle's corners) replace the samples either side of each corner with a
+ * polynomial that rounds it off, using only the phase and its step.
+ */
+
+#ifndef _FAD_NCO_H_
+#define _FAD_NCO_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fad_fixed.h"
+
+/* Entries per quarter wave. The table holds one more, so the last entry can be interpolated to */
+#define FAD_NCO_TABLE_BITS 8
+#define FAD_NCO_TABLE_SIZE (1 << FAD_NCO_TABLE_BITS)
+
+/* Phase of a quarter cycle */
+#define FAD_NCO_QUARTER (1u << 30)
+
+/* sin(pi/2 * k / FAD_NCO_TABLE_SIZE), Q15, k = 0 .. FAD_NCO_TABLE_SIZE */
+extern const fad_q15_t fad_nco_table[FAD_NCO_TABLE_SIZE + 1];
+
+/* An oscillator */
+typedef struct {
+    uint32_t phase;     // Current phase. 2^32 is one cycle
+    uint32_t step;      // Phase added per sample. Negative frequencies wrap
+    bool interpolate;   // Interpolate between table entries
+} fad_nco_t;
+
+/**
+ * @brief Sine of a phase, Q15
+ * @param phase The phase. 2^32 is one cycle
+ * @param interpolate Interpolate linearly between table entries
+ */
+static inline fad_q15_t fad_nco_sine(uint32_t phase, bool interpolate)
+{
+    /* Top 2 bits pick the quadrant, the next FAD_NCO_TABLE_BITS the entry, and the rest the fraction */
+    uint32_t quadrant = phase >> 30;
+    int index = (phase >> (30 - FAD_NCO_TABLE_BITS)) & (FAD_NCO_TABLE_SIZE - 1);
+    int32_t a, b;
+
+    /* The second and fourth quadrants read the table backwards */
+    if (quadrant & 1)
+    {
+        a = fad_nco_table[FAD_NCO_TABLE_SIZE - index];
+        b = fad_nco_table[FAD_NCO_TABLE_SIZE - index - 1];
+    }
+    else
+    {
+        a = fad_nco_table[index];
+        b = fad_nco_table[index + 1];
+    }
+
+    if (interpolate)
+    {
+        int32_t frac = (phase >> (15 - FAD_NCO_TABLE_BITS)) & 0x7FFF;
+        a += ((b - a) * frac) >> 15;
+    }
+
+    /* The second half of the cycle is the first, negated */
+    return (fad_q15_t)(quadrant & 2 ? -a : a);
+}
+
+/**
+ * @brief Prepare an oscillator at phase 0
+ * @param nco [OUT] The oscillator
+ * @param freq Frequency in Hz. Negative frequencies run backwards
+ * @param rate Sample rate in Hz
+ * @param interpolate Interpolate linearly between table entries
+ */
+void fad_nco_init(fad_nco_t *nco, int freq, int rate, bool interpolate);
+
+/**
+ * @brief Change the frequency, keeping the phase so the output stays continuous
+ * @param nco The oscillator
+ * @param freq Frequency in Hz. Negative frequencies run backwards
+ * @param rate Sample rate in Hz
+ */
+void fad_nco_set_freq(fad_nco_t *nco, int freq, int rate);
+
+/**
+ * @brief Change the frequency to that of a period, keeping the phase
+ * @param nco The oscillator
+ * @param period Period in samples, Q16. More than 2 samples
+ */
+void fad_nco_set_period(fad_nco_t *nco, int32_t period);
+
+/**
+ * @brief Produce the next sine and cosine sample and advance the oscillator
+ * @param nco The oscillator
+ * @param cos_out [OUT] The cosine, Q15
+ * @param sin_out [OUT] The sine, Q15
+ */
+static inline void fad_nco_next_quad(fad_nco_t *nco, fad_q15_t *cos_out, fad_q15_t *sin_out)
+{
+    *cos_out = fad_nco_sine(nco->phase + FAD_NCO_QUARTER, nco->interpolate);
+    *sin_out = fad_nco_sine(nco->phase, nco->interpolate);
+    nco->phase += nco->step;
+}
+
+/**
+ * @brief Produce a block of sine samples
+ * @param nco The oscillator
+ * @param out [OUT] The samples, Q15
+ * @param len Number of samples
+ */
+void fad_nco_sin(fad_nco_t *nco, fad_q15_t *out, int len);
+
+/**
+ * @brief Produce a block of cosine samples
+ * @param nco The oscillator
+ * @param out [OUT] The samples, Q15
+ * @param len Number of samples
+ */
+void fad_nco_cos(fad_nco_t *nco, fad_q15_t *out, int len);
+
+/**
+ * @brief Produce a block of quadrature pairs: the cosine and sine of the same phases
+ * @param nco The oscillator
+ * @param cos_out [OUT] The cosine samples, Q15
+ * @param sin_out [OUT] The sine samples, Q15
+ * @param len Number of pairs
+ */
+void fad_nco_quad(fad_nco_t *nco, fad_q15_t *cos_out, fad_q15_t *sin_out, int len);
+
+/**
+ * @brief Produce a block of a band-limited rising sawtooth, -1 to 1 (PolyBLEP). The frequency must be
+ * positive and below half the rate; the table setting of the oscillator is not used
+ * @param nco The oscillator
+ * @param out [OUT] The samples, Q15
+ * @param len Number of samples
+ */
+void fad_nco_saw(fad_nco_t *nco, fad_q15_t *out, int len);
+
+/**
+ * @brief Produce a block of a band-limited triangle, -1 at phase 0 and 1 at half a cycle (PolyBLAMP).
+ * The frequency must be positive and below half the rate; the table setting of the oscillator is not used
+ * @param nco The oscillator
+ * @param out [OUT] The samples, Q15
+ * @param len Number of samples
+ */
+void fad_nco_triangle(fad_nco_t *nco, fad_q15_t *out, int len);
+
+#endif
@@ -0,0 +1,178 @@
+/**
+ * fad_pitch.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Voice pitch tracking. Samples are low-passed at FAD_PITCH_LOWPASS_HZ and decimated by
+ * FAD_PITCH_DECIMATE as they are written, to about 2.7 kHz at OUTPUT_FREQ, which still holds the
+ * fundamental and first harmonics of a voice. An estimate runs YIN over the latest FAD_PITCH_WINDOW
+ * decimated samples: the difference between the window and itself one lag later, for every lag of a
+ * 50 - 500 Hz period, normalized by its running mean. The first lag whose normalized difference falls
+ * under FAD_PITCH_YIN_THRESHOLD, moved to its local minimum, is the period. A high voice's period
+ * spans only a few lags, so if a minimum near a third or a half of that lag is under
+ * FAD_PITCH_YIN_SUBMULTIPLE_THRESHOLD, it is taken instead. The period is then refined between lags.
+ *
+ * All in fixed point, and the cost of an estimate does not depend on the input: FAD_PITCH_YIN_MACS
+ * multiply-accumulates and FAD_PITCH_MAX_LAG divisions. Run one per block.
+ *
+ * The harmonic product spectrum (HPS) estimator works on the spectrum instead, so it is more robust
+ * to noise, at the cost of a float rfft. Samples are decimated by FAD_PITCH_HPS_DECIMATE into a
+ * frame of FAD_PITCH_HPS_FRAME, which is Hann-windowed and transformed with a plan prepared once. The
+ * power of each bin (no square root) is multiplied by the power at 2, 3 .. FAD_PITCH_HPS_HARMONICS
+ * times its frequency; the harmonics of a voice line up only at its fundamental, so that bin stands
+ * out. In heavy noise the product can peak at a half or a third of the fundamental instead, so the peak
+ * is moved up while the harmonics that are not multiples of 2 (or 3) hold less power than those that
+ * are. Each harmonic's peak is then placed between bins with a parabola through the log of its
+ * neighbours, and the fundamental is fitted to them all, weighted by power. The confidence is how much
+ * more of the power lies on its harmonics than would for white noise. An estimate is too costly for
+ * every block, so it runs once every few calls.
+ */
+
+#ifndef _FAD_PITCH_H_
+#define _FAD_PITCH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fad_defs.h"
+#include "fad_fixed.h"
+#include "fft.h"
+
+/* Input samples per decimated sample */
+#define FAD_PITCH_DECIMATE 4
+
+/* Corner of the low-pass in front of the decimation, Hz, and the biquad sections it is built from */
+#define FAD_PITCH_LOWPASS_HZ 1000
+#define FAD_PITCH_LOWPASS_SECTIONS 2
+
+/* Rate of the decimated samples, Hz */
+#define FAD_PITCH_RATE (OUTPUT_FREQ / FAD_PITCH_DECIMATE)
+
+/* Range of periods searched, in decimated samples: 500 Hz down to 50 Hz */
+#define FAD_PITCH_MIN_LAG (FAD_PITCH_RATE / 500)
+#define FAD_PITCH_MAX_LAG (FAD_PITCH_RATE / 50 + 1)
+
+/* Decimated samples compared at each lag. At least the longest period */
+#define FAD_PITCH_WINDOW 64
+
+/* Decimated samples kept: a window, plus the longest lag past it. A power of two */
+#define FAD_PITCH_HISTORY 128
+
+/* Normalized difference under which a lag is taken as the period, Q15 */
+#define FAD_PITCH_YIN_THRESHOLD FAD_Q15(0.15)
+
+/* Normalized difference under which a half or a third of the period is taken instead, Q15 */
+#define FAD_PITCH_YIN_SUBMULTIPLE_THRESHOLD FAD_Q15(0.3)
+
+/* Multiply-accumulates per estimate */
+#define FAD_PITCH_YIN_MACS (FAD_PITCH_WINDOW * FAD_PITCH_MAX_LAG)
+
+/* Input samples averaged into each decimated sample of the HPS frame. A power of two */
+#define FAD_PITCH_HPS_DECIMATE 2
+
+/* Decimated samples per HPS frame (93 ms at OUTPUT_FREQ). A power of two */
+#define FAD_PITCH_HPS_FRAME 512
+
+/* Harmonics multiplied into each bin of the product */
+#define FAD_PITCH_HPS_HARMONICS 4
+
+/* Range of fundamentals searched, in bins of the HPS frame: 50 Hz to 500 Hz */
+#define FAD_PITCH_HPS_MIN_BIN (50 * FAD_PITCH_HPS_FRAME * FAD_PITCH_HPS_DECIMATE / OUTPUT_FREQ + 1)
+#define FAD_PITCH_HPS_MAX_BIN (500 * FAD_PITCH_HPS_FRAME * FAD_PITCH_HPS_DECIMATE / OUTPUT_FREQ + 1)
+
+/* Confidence above which an HPS estimate is voiced, Q15 */
+#define FAD_PITCH_HPS_MIN_CONFIDENCE FAD_Q15(0.5)
+
+/* An estimate */
+typedef struct {
+    int32_t period;         // Period in input samples, Q16
+    fad_q15_t confidence;   // Q15. Near 1 for a clean voice. YIN: 1 less the normalized difference at the period. HPS: how much more of the power lies on its harmonics than would for white noise
+    bool voiced;            // The confidence passed the estimator's threshold
+} fad_pitch_t;
+
+/* A section of the low-pass */
+typedef struct {
+    int32_t b[3];           // Feed-forward coefficients, Q28
+    int32_t a[2];           // Feedback coefficients, Q28, with a0 = 1 left out
+    int32_t x[2];           // Last two inputs, newest first, Q23
+    int32_t y[2];           // Last two outputs, newest first, Q23
+} fad_pitch_biquad_t;
+
+/* A pitch tracker */
+typedef struct {
+    fad_pitch_biquad_t lowpass[FAD_PITCH_LOWPASS_SECTIONS];
+    int count;              // Input samples since the last decimated sample
+    int pos;                // Ring position of the next decimated sample
+    fad_q15_t history[FAD_PITCH_HISTORY];   // Decimated samples, a ring
+} fad_pitch_yin_t;
+
+/**
+ * @brief Prepare a silent tracker
+ * @param yin [OUT] The tracker
+ */
+void fad_pitch_yin_init(fad_pitch_yin_t *yin);
+
+/**
+ * @brief Low-pass and decimate samples into the tracker's history
+ * @param yin The tracker
+ * @param in The samples
+ * @param len Number of samples
+ */
+void fad_pitch_yin_write(fad_pitch_yin_t *yin, const fad_q15_t *in, int len);
+
+/**
+ * @brief Estimate the pitch of the latest window. Costs the same for any input.
+ * @param yin The tracker
+ * @param est [OUT] The estimate. If no lag falls under the threshold, the lag with the least
+ * normalized difference is given, not voiced
+ */
+void fad_pitch_yin_estimate(const fad_pitch_yin_t *yin, fad_pitch_t *est);
+
+/* An HPS pitch estimator. The frame, its transform and the plan are held inline, so nothing is allocated */
+typedef struct {
+    int32_t acc;            // Sum of the input samples of the decimated sample in progress
+    int count;              // Input samples in acc
+    int pos;                // Ring position of the next decimated sample
+    int interval;           // Calls to fad_pitch_hps_estimate per estimate
+    int countdown;          // Calls until the next estimate
+    fft_config_t plan;
+    fad_q15_t history[FAD_PITCH_HPS_FRAME];     // Decimated samples, a ring
+    float window[FAD_PITCH_HPS_FRAME];          // Hann window
+    float frame[FAD_PITCH_HPS_FRAME];           // Windowed frame, into rfft
+    float spectrum[FAD_PITCH_HPS_FRAME];        // rfft output: DC and Nyquist, then re/im pairs
+    float twiddles[FFT_TWIDDLE_LEN(FAD_PITCH_HPS_FRAME)];
+} fad_pitch_hps_t;
+
+/**
+ * @brief Prepare a silent HPS estimator and its FFT plan
+ * @param hps [OUT] The estimator
+ * @param interval Calls to fad_pitch_hps_estimate per estimate; 1 estimates on every call
+ */
+void fad_pitch_hps_init(fad_pitch_hps_t *hps, int interval);
+
+/**
+ * @brief Decimate samples into the estimator's frame
+ * @param hps The estimator
+ * @param in The samples
+ * @param len Number of samples
+ */
+void fad_pitch_hps_write(fad_pitch_hps_t *hps, const fad_q15_t *in, int len);
+
+/**
+ * @brief Estimate the pitch of the latest frame, once every interval calls
+ * @param hps The estimator
+ * @param est [OUT] The estimate. Left alone on calls that do not estimate
+ * @return True if est was updated
+ */
+bool fad_pitch_hps_estimate(fad_pitch_hps_t *hps, fad_pitch_t *est);
+
+/**
+ * @brief Frequency of a period, Hz, Q16
+ * @param period Period in input samples, Q16. Greater than 0
+ */
+static inline uint32_t fad_pitch_hz(int32_t period)
+{
+    return (uint32_t)(((uint64_t)OUTPUT_FREQ << 32) / (uint32_t)period);
+}
+
+#endif
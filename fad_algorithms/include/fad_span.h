@@ -0,0 +1,123 @@
+/**
+ * fad_span.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Spans describe a block of samples inside a circular buffer as one or two contiguous segments.
+ * The second segment is only used when the block wraps past the end of the buffer. Algorithms
+ * receive their input and output as spans, so they never index the circular buffers directly
+ * and never need to check for wrap inside their loops.
+ *
+ * Algorithm samples are signed Q15 (see fad_convert.h), so the output of one algorithm can be the
+ * input of the next. The raw ADC block is converted to Q15 once on the way in, and the last
+ * output is converted to 8-bit DAC values on the way out.
+ */
+
+#ifndef _FAD_SPAN_H_
+#define _FAD_SPAN_H_
+
+#include <stdint.h>
+#include "fad_fixed.h"
+
+/* Maximum number of runs a pair of spans can split into (two wrap points) */
+#define FAD_SPAN_MAX_RUNS 3
+
+/* A block of Q15 samples. seg[1] is NULL and len[1] is 0 unless the block wraps. */
+typedef struct {
+    fad_q15_t *seg[2];
+    int len[2];
+} fad_span_t;
+
+/* A block of raw 12-bit ADC values. seg[1] is NULL and len[1] is 0 unless the block wraps. */
+typedef struct {
+    uint16_t *seg[2];
+    int len[2];
+} fad_adc_span_t;
+
+/* A block of 8-bit DAC values. seg[1] is NULL and len[1] is 0 unless the block wraps. */
+typedef struct {
+    uint8_t *seg[2];
+    int len[2];
+} fad_dac_span_t;
+
+/* A stretch of a block that is contiguous in both the input and output spans */
+typedef struct {
+    const fad_q15_t *in;
+    fad_q15_t *out;
+    int len;
+} fad_span_run_t;
+
+/**
+ * @brief Describe len samples of a circular buffer, starting at pos
+ * @param span [OUT] The span to fill
+ * @param buff The circular buffer
+ * @param buff_size Number of values in buff
+ * @param pos Index of the first value of the block. Must be less than buff_size
+ * @param len Number of values in the block. Must not exceed buff_size
+ */
+void fad_span_init(fad_span_t *span, fad_q15_t *buff, int buff_size, int pos, int len);
+
+/**
+ * @brief Describe len values of a circular ADC buffer, starting at pos
+ * @param span [OUT] The span to fill
+ * @param buff The circular buffer
+ * @param buff_size Number of values in buff
+ * @param pos Index of the first value of the block. Must be less than buff_size
+ * @param len Number of values in the block. Must not exceed buff_size
+ */
+void fad_adc_span_init(fad_adc_span_t *span, uint16_t *buff, int buff_size, int pos, int len);
+
+/**
+ * @brief Describe len values of a circular DAC buffer, starting at pos
+ * @param span [OUT] The span to fill
+ * @param buff The circular buffer
+ * @param buff_size Number of values in buff
+ * @param pos Index of the first value of the block. Must be less than buff_size
+ * @param len Number of values in the block. Must not exceed buff_size
+ */
+void fad_dac_span_init(fad_dac_span_t *span, uint8_t *buff, int buff_size, int pos, int len);
+
+/**
+ * @brief Split an input and output span of equal length into runs that are contiguous in both.
+ * Value i of the input block corresponds to value i of the output block.
+ * @param in The input span
+ * @param out The output span
+ * @param runs [OUT] The runs, in block order
+ * @return Number of runs written to runs (1 to FAD_SPAN_MAX_RUNS)
+ */
+int fad_span_runs(const fad_span_t *in, const fad_span_t *out, fad_span_run_t runs[FAD_SPAN_MAX_RUNS]);
+
+/**
+ * @brief Convert a block of Q15 samples to 8-bit DAC values
+ * @param in The samples. Same length as out
+ * @param out [OUT] The DAC values
+ */
+void fad_span_to_dac(const fad_span_t *in, const fad_dac_span_t *out);
+
+/**
+ * @brief Convert a block of ADC values to Q15 samples, averaging each group of factor consecutive
+ * values into one sample for multisampled capture. Uses the kernel specialized for the app's block and MULTISAMPLES.
+ * @param in The ADC values. Its length should be a multiple of factor; a partial last group is dropped
+ * @param out [OUT] Contiguous buffer for (in length) / factor samples
+ * @param factor Number of ADC values per sample
+ */
+void fad_span_from_adc(const fad_adc_span_t *in, fad_q15_t *out, int factor);
+
+/**
+ * @brief Total number of values in a span
+ */
+static inline int fad_span_len(const fad_span_t *span)
+{
+    return span->len[0] + span->len[1];
+}
+
+/**
+ * @brief Total number of values in a span
+ */
+static inline int fad_dac_span_len(const fad_dac_span_t *span)
+{
+    return span->len[0] + span->len[1];
+}
+
+#endif
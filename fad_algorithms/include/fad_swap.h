@@ -0,0 +1,119 @@
+/**
+ * fad_swap.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Glitch-free algorithm changes. Holds two chains: the active chain feeds the output while the
+ * other is built with the new algorithm. Once the new chain is committed, the audio path runs both
+ * for fade_len samples and crossfades from the old output to the new one. The old chain is then
+ * retired, and its state is released later by fad_swap_release, outside the audio path. Each chain
+ * has its own arena bank, so the old and new state can be held at the same time.
+ *
+ * All functions must be called from the same task (in fad_project_bt, the app task that handles
+ * both FAD_ALGO_CHANGED and FAD_ADC_BUFFER_READY).
+ */
+
+#ifndef _FAD_SWAP_H_
+#define _FAD_SWAP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fad_chain.h"
+
+/* Default crossfade length in output samples (about 23 ms at OUTPUT_FREQ) */
+#define FAD_SWAP_FADE_LEN 256
+
+/* Crossfade gain of 1.0. Gains are Q15 so that (new - old) * gain fits in 32 bits */
+#define FAD_SWAP_GAIN_ONE (1 << 15)
+
+typedef enum {
+    FAD_SWAP_IDLE,      // Only the active chain exists
+    FAD_SWAP_PENDING,   // The new chain is built; fade starts on the next block
+    FAD_SWAP_FADING,    // Both chains run, output crossfades from old to new
+    FAD_SWAP_RETIRED,   // The new chain is active; the old chain awaits fad_swap_release
+} fad_swap_state_t;
+
+typedef struct {
+    fad_chain_t chains[2];
+    int active;             // Index of the chain feeding the output
+    fad_swap_state_t state;
+    fad_q15_t *fade_buff;   // Holds the old chain's output during a fade
+    int fade_len;           // Crossfade length in samples
+    int fade_step;          // Gain step per sample, Q15
+    int fade_gain;          // Current gain of the new chain, Q15
+} fad_swap_t;
+
+/**
+ * @brief Prepare the swapper with two empty chains. Does not allocate.
+ * @param swap [OUT] The swapper
+ * @param scratch_a First scratch buffer, shared by both chains
+ * @param scratch_b Second scratch buffer, shared by both chains
+ * @param fade_buff Third buffer for the crossfade
+ * @param scratch_len Number of samples in each buffer
+ * @param fade_len Crossfade length in samples. At least 1
+ * @param bank_a Arena bank for the state of the first chain
+ * @param bank_b Arena bank for the state of the second chain
+ * @param bank_size Number of bytes in each bank. FAD_ALGO_BANK_SIZE holds any registry entry
+ */
+void fad_swap_init(fad_swap_t *swap, fad_q15_t *scratch_a, fad_q15_t *scratch_b, fad_q15_t *fade_buff, int scratch_len, int fade_len,
+                   void *bank_a, void *bank_b, size_t bank_size);
+
+/**
+ * @brief Get an empty chain to build the next algorithm into. If a fade is in progress it is completed
+ * immediately, and a retired chain is released.
+ * @param swap The swapper
+ * @return The chain to fill with fad_chain_add before calling fad_swap_commit
+ */
+fad_chain_t *fad_swap_stage(fad_swap_t *swap);
+
+/**
+ * @brief Start fading to the chain returned by fad_swap_stage on the next block
+ * @param swap The swapper
+ */
+void fad_swap_commit(fad_swap_t *swap);
+
+/**
+ * @brief Retune the active chain to another mode of the same algorithm type without a swap. Use instead of
+ * fad_swap_stage when only the mode changes, so state such as delay buffers carries over with no crossfade.
+ * @param swap The swapper
+ * @param type The algorithm type the active chain was built with
+ * @param mode The new algorithm mode
+ * @return
+ *      -ESP_OK if the active chain was retuned
+ *      -ESP_ERR_INVALID_STATE if a swap is in progress or the active chain is not type
+ *      -ESP_ERR_NOT_SUPPORTED if a stage of the chain cannot be retuned
+ *      Nothing is changed on error; build a new chain instead.
+ */
+esp_err_t fad_swap_update(fad_swap_t *swap, fad_algo_type_t type, fad_algo_mode_t mode);
+
+/**
+ * @brief Discard the chain returned by fad_swap_stage without using it
+ * @param swap The swapper
+ */
+void fad_swap_abort(fad_swap_t *swap);
+
+/**
+ * @brief Process one block through the active chain, crossfading if a swap is in progress
+ * @param swap The swapper
+ * @param in The block of input samples
+ * @param out [OUT] The block of DAC values. Same length as in
+ * @return true if the old chain was retired during this block. Call fad_swap_release outside the audio path.
+ */
+bool fad_swap_process(fad_swap_t *swap, const fad_span_t *in, const fad_dac_span_t *out);
+
+/**
+ * @brief Deinitialize a retired chain and release its state. Does nothing in any other state.
+ * @param swap The swapper
+ */
+void fad_swap_release(fad_swap_t *swap);
+
+/**
+ * @brief The chain currently feeding the output
+ */
+static inline fad_chain_t *fad_swap_active(fad_swap_t *swap)
+{
+    return &swap->chains[swap->active];
+}
+
+#endif
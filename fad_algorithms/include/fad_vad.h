@@ -0,0 +1,74 @@
+/**
+ * fad_vad.h
+ * Organization: Messiah Collaboratory
+ * Date: 10/17/2026
+ *
+ * Description:
+ * Voice activity detection, once per block. A block is voiced when its energy stands
+ * FAD_VAD_ONSET_RATIO above the tracked noise floor and it crosses zero no more often than voiced
+ * speech does; much louder blocks count whatever their zero-crossing rate, so fricatives are not
+ * missed. Voice is held for FAD_VAD_HANGOVER samples after the last voiced block, so pauses between
+ * words do not cut it off.
+ *
+ * The noise floor drops to any quieter block at once and rises slowly, more slowly during voice, so
+ * it follows a changing background without learning speech as noise. Costs one multiply-accumulate
+ * and one compare per sample, and one division per block.
+ */
+
+#ifndef _FAD_VAD_H_
+#define _FAD_VAD_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fad_defs.h"
+#include "fad_span.h"
+
+/* Samples voice is held after the last voiced block (300 ms at OUTPUT_FREQ) */
+#define FAD_VAD_HANGOVER (OUTPUT_FREQ * 3 / 10)
+
+/* Energy over the noise floor that marks a voiced block (6 dB) */
+#define FAD_VAD_ONSET_RATIO 4
+
+/* Energy over the noise floor that marks a voiced block whatever its zero-crossing rate (18 dB) */
+#define FAD_VAD_LOUD_RATIO 64
+
+/* Lowest noise floor, as a mean square of Q15 samples (-60 dBFS) */
+#define FAD_VAD_MIN_FLOOR 1074
+
+/* Zero crossings per sample above which a block is taken as noise unless it is loud, Q15 */
+#define FAD_VAD_MAX_ZCR FAD_Q15(0.25)
+
+/* A detector */
+typedef struct {
+    uint32_t floor;         // Noise floor, mean square of Q15 samples
+    uint32_t energy;        // Mean square of the last block
+    fad_q15_t zcr;          // Zero crossings per sample of the last block, Q15
+    fad_q15_t last;         // Last sample of the last block, so crossings between blocks count
+    int hangover;           // Samples voice is still held for
+    bool active;            // Voice in the last block, or held from an earlier one
+} fad_vad_t;
+
+/**
+ * @brief Prepare a detector that hears no voice
+ * @param vad [OUT] The detector
+ */
+void fad_vad_init(fad_vad_t *vad);
+
+/**
+ * @brief Measure a block and decide whether it holds voice
+ * @param vad The detector
+ * @param in The block of input samples
+ * @return True if voice is present or held
+ */
+bool fad_vad_update(fad_vad_t *vad, const fad_span_t *in);
+
+/**
+ * @brief Whether the last block held voice, or it is still held
+ * @param vad The detector
+ */
+static inline bool fad_vad_active(const fad_vad_t *vad)
+{
+    return vad->active;
+}
+
+#endif
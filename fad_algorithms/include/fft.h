@@ -63,7 +63,12 @@ typedef struct
   unsigned int flags; // FFT flags
 } fft_config_t;
 
+#define FFT_TWIDDLE_LEN(size) (2 * (size))  // floats of twiddle factors for an FFT of size
+
 fft_config_t *fft_init(int size, fft_type_t type, fft_direction_t direction, float *input, float *output);
+// Same as fft_init, but uses caller memory and allocates nothing. twiddle_factors holds FFT_TWIDDLE_LEN(size) floats.
+// input and output must be provided. Do not call fft_destroy on the result.
+fft_config_t *fft_init_static(fft_config_t *config, int size, fft_type_t type, fft_direction_t direction, float *input, float *output, float *twiddle_factors);
 void fft_destroy(fft_config_t *config);
 void fft_execute(fft_config_t *config);
 void fft(float *input, float *output, float *twiddle_factors, int n);
@@ -24,6 +24,14 @@
 
 static const char *ADC_TAG = "ADC";
 
+/* Shared sample buffers and positions, declared in fad_defs.h */
+uint16_t *adc_buffer;
+uint8_t *dac_buffer;
+uint16_t adc_buffer_pos;
+uint16_t dac_buffer_pos;
+uint16_t adc_buffer_pos_copy;
+uint16_t dac_buffer_pos_copy;
+
 /**
  * @brief	Initialize input buffer for ADC data, as well as DAC buffer for output
  * @return
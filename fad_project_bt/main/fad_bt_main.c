@@ -24,6 +24,7 @@
 #include "fad_bt_main.h"
 #include "fad_app_core.h"
 #include "fad_defs.h"
+#include "fad_convert.h"
 #include "main.h"
 
 // AVRCP used transaction label
@@ -138,6 +139,8 @@ void fad_bt_init()
         return;
     }
 
+    /* The algorithm banks and buffers are static, so this is what is left for A2DP and the tasks */
+    ESP_LOGI(BT_TAG, "Bluedroid enabled, %u bytes of heap free", (unsigned)esp_get_free_heap_size());
 }
 
 static int32_t bt_app_a2d_data_cb(uint8_t *data, int32_t len)
@@ -162,31 +165,26 @@ static int32_t bt_app_a2d_data_cb(uint8_t *data, int32_t len)
     }
 
     /* 
-    *  Output is formatted as follows: Left lower byte, left upper, right lower byte, right upper
-    *  Our input is mono 8 bit, so right and left are equal with lower bytes set to 0
+    *  Output is 16-bit stereo, left then right. Our input is mono 8 bit, so right and left are equal.
     *  Also, we utilize aliasing to transform our ~11 kHz output to 44.1 kHz
     */
 
-    /* Sets how many outputs a single FAD output will expand to.
-    4 for 8-bit mono to 16-bit stereo conversion, rest for aliasing */
+    /* Bytes a single FAD output expands to: one 4-byte stereo frame per aliased value */
     int scaler = FAD_OUTPUT_BT_ALIASING * 4;
+    int16_t *frames = (int16_t *)data;
+    int count = len / scaler;
 
-
-    for (int i = 0; i < (len / scaler); i++) // for loop to go through each fad output value
+    while (count > 0) // convert up to the end of the circular buffer, then wrap
     {
-        for (int j = 0; j < FAD_OUTPUT_BT_ALIASING; j++)
-        {
-            // set lower bytes to 0
-            data[(scaler * i) + (4 * j) + 0] = 0;
-            data[(scaler * i) + (4 * j) + 2] = 0;
+        int run = DAC_BUFFER_SIZE - s_out_pos;
+        if (run > count) run = count;
 
-            // set left and right upper bytes to value
-            data[(scaler * i) + (4 * j) + 1] = dac_buffer[s_out_pos];
-            data[(scaler * i) + (4 * j) + 3] = dac_buffer[s_out_pos];
-        }
+        fad_convert_dac_to_stereo(&dac_buffer[s_out_pos], frames, run, FAD_OUTPUT_BT_ALIASING);
+        frames += run * FAD_OUTPUT_BT_ALIASING * 2;
+        count -= run;
 
         /* Advance and wrap buffer */
-        s_out_pos++;
+        s_out_pos += run;
         if (s_out_pos >= DAC_BUFFER_SIZE)
             s_out_pos = 0;
     }
@@ -24,6 +24,7 @@
 #include "fad_defs.h"
 #include "fad_app_core.h"
 #include "fad_gpio.h"
+#include "fad_log.h"
 
 #define TIMER_GROUP TIMER_GROUP_0
 #define TIMER_NUMBER TIMER_0
@@ -39,6 +40,7 @@ static xTaskHandle s_algo_notify_task_handle;
 static const char *TIMER_TAG = "TIMER";
 static bool s_timer_running = 0; 	// keep track of whether timer is on
 static int s_adc_read_size = 0;
+static int s_adc_block_count = 0;	// ADC readings taken since the last algorithm notify
 static fad_output_mode_t s_output_mode = FAD_OUTPUT_DAC;
 
 /**
@@ -74,8 +76,10 @@ void IRAM_ATTR timer_intr_handler(void *arg)
 		
 	}
 
-	if (adc_buffer_pos % s_adc_read_size == 0)
+	/* Count readings rather than test the buffer position, so the read size need not divide the buffer size. Algorithms get spans that handle the wrap */
+	if (++s_adc_block_count == s_adc_read_size)
 	{
+		s_adc_block_count = 0;
 		adc_buffer_pos_copy = adc_buffer_pos; //these copies provide a stable reference for the algorithm to work on
 		dac_buffer_pos_copy = dac_buffer_pos;
 
@@ -105,7 +109,7 @@ static void alarm_task(void *params)
 			.adc_buff_pos_info.dac_pos = dac_buffer_pos_copy,
 		};
 		
-		ESP_LOGI(TIMER_TAG, "ADC Buffer: %d", adc_buffer[adc_buffer_pos]);
+		FAD_LOGD(TIMER_TAG, "ADC Buffer: %d", adc_buffer[adc_buffer_pos]);
 		fad_app_work_dispatch(fad_main_stack_evt_handler, FAD_ADC_BUFFER_READY, (void *)&params, sizeof(fad_main_cb_param_t), NULL);
 	}
 
@@ -172,6 +176,7 @@ void adc_timer_stop(void)
 	dac_buffer_pos_copy = 0;
 	adc_buffer_pos = 0;
 	adc_buffer_pos_copy = 0;
+	s_adc_block_count = 0;
 }
 
 esp_err_t adc_timer_set_read_size(int adc_read_size)
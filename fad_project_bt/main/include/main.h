@@ -17,6 +17,7 @@ enum {
 	FAD_DAC_BUFFER_READY,
 	FAD_ADC_BUFFER_READY,
 	FAD_ALGO_CHANGED,
+	FAD_ALGO_RETIRED,
 } stack_evt;
 
 /** 
@@ -34,16 +34,21 @@
 #include "fad_bt_gap.h"
 #include "fad_gpio.h"
 
-#include "algo_template.h"
-#include "algo_delay.h"
-#include "algo_freq_shift.h"
-#include "algo_masking.h"
+#include "algo_registry.h"
+#include "fad_swap.h"
+#include "fad_log.h"
+#include "fad_convert.h"
 //#include "fft.h" //Not used anymore
 
 
 #define FAD_TAG "FAD" //Simple ID for the program 
 #define FAD_NVS_NAMESPACE "FAD_BT" // Needed for NVS storage utilization
 
+/* Period and priority of the task that prints deferred log records. Lowest above idle, so it never delays audio */
+#define LOG_DRAIN_PERIOD_MS 100
+#define LOG_DRAIN_PRIORITY (tskIDLE_PRIORITY + 1)
+#define LOG_DRAIN_STACK_DEPTH 3072
+
 /* Determines whether program starts with test event. 0 for no test event, 1 for test event */
 #define TEST_MODE 0
 
@@ -53,16 +58,38 @@ static char s_nvs_algo_key[15] = "NVS_ALGO_INFO";
 static esp_bd_addr_t s_peer_bda = {0, 0, 0, 0, 0, 0};
 
 /* Algo function variables, subject to change on algorithm change. */
-static algo_func_t s_algo_func = algo_masking; //was algo_template Change this to test <<<<<<<<<<<<<<
-static int s_algo_read_size = 512;
-static algo_deinit_func_t s_algo_deinit_func = algo_delay_deinit;
+static fad_swap_t s_algo_swap;	// The running algorithm chain, and the next one while changing. Empty (pass-through) until first handle_algo_change
+static fad_q15_t s_algo_scratch[3][FAD_BLOCK_SIZE / MULTISAMPLES];	// Ping-pong and crossfade buffers for s_algo_swap, allocated once
+static uint8_t s_algo_banks[2][FAD_ALGO_BANK_SIZE] __attribute__((aligned(FAD_ARENA_ALIGN)));	// Algorithm state for each chain of s_algo_swap, reserved at boot
+static fad_q15_t s_algo_input[FAD_BLOCK_SIZE / MULTISAMPLES];	// ADC block converted to Q15, averaged down to one sample per output
+static fad_dc_block_t s_input_dc;	// Removes the microphone bias from every block, before any algorithm sees it
 
 /* Testing vars */
 static int s_adc_calls = 0;
 
+/* Prints the records the audio path logged through fad_log.h */
+static void log_drain_task(void *params)
+{
+	for (;;)
+	{
+		fad_log_drain();
+		vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_PERIOD_MS));
+	}
+}
+
 /* Called on ESP32 startup */ //First file to run
 void app_main(void)
 {
+	fad_log_init();
+	fad_dc_block_init(&s_input_dc);
+	if (xTaskCreate(log_drain_task, "Log_Drain_Task", LOG_DRAIN_STACK_DEPTH, NULL, LOG_DRAIN_PRIORITY, NULL) != pdPASS)
+	{
+		ESP_LOGW(FAD_TAG, "Couldn't create log drain task");
+	}
+
+	fad_swap_init(&s_algo_swap, s_algo_scratch[0], s_algo_scratch[1], s_algo_scratch[2], FAD_BLOCK_SIZE / MULTISAMPLES, FAD_SWAP_FADE_LEN,
+				  s_algo_banks[0], s_algo_banks[1], FAD_ALGO_BANK_SIZE);
+
 	/* create application task. Used to send events to event handlers */
 	fad_app_task_startup();
 
@@ -161,70 +188,35 @@ void get_addr_in_nvs()
 	memcpy(s_peer_bda, &encoded_addr, 6);
 }
 
-/* Parse new algorithm and initialize / setup based on new algo */
+/* Parse new algorithm and initialize / setup based on new algo. A new mode of the running algorithm is retuned in place when it supports it.
+   Otherwise the current algorithm keeps running until the new one is built, then the audio path crossfades to it.
+   Every algorithm runs on FAD_BLOCK_SIZE blocks, so the timer keeps notifying at the same interval through the swap */
 void handle_algo_change(fad_algo_type_t type, fad_algo_mode_t mode)
 {
-	s_algo_deinit_func();
+	const fad_algo_desc_t *desc = fad_algo_get_desc(type);
+	if (desc == NULL)
+	{
+		ESP_LOGI(FAD_TAG, "Unhandled algo function %d", type);
+		return;
+	}
 
-	switch (type)
+	if (fad_swap_update(&s_algo_swap, type, mode) == ESP_OK)
 	{
-	case FAD_ALGO_TEMPLATE:
-		ESP_LOGI(FAD_TAG, "Changing algo to Template, Mode %d", mode);
-		s_algo_func = algo_template;
-		s_algo_deinit_func = algo_template_deinit;
-		s_algo_read_size = 512;
-		int template_period = 0;
-		switch (mode)
-		{
-		case FAD_ALGO_MODE_1:
-			template_period = 8;
-			break;
-		case FAD_ALGO_MODE_2:
-			template_period = 16;
-			break;
-		case FAD_ALGO_MODE_3:
-			template_period = 64;
-			break;
-		default:
-			break;
-		}
-		fad_algo_init_params_t init_params = {
-			.algo_template_params.read_size = s_algo_read_size,
-			.algo_template_params.period = template_period
-		};
-		algo_template_init(&init_params);
-		break;
+		ESP_LOGI(FAD_TAG, "Retuned %s to Mode %d", desc->name, mode);
+		return;
+	}
 
-	case FAD_ALGO_FREQ_SHIFT:
-		ESP_LOGI(FAD_TAG, "Changing algo to Template, Mode %d", mode);
-		s_algo_func = algo_freq_shift;
-		s_algo_deinit_func = algo_delay_deinit;
-		s_algo_read_size = 512;
-		int shift_amount = 2;
-		algo_freq_init();
-		//algo_freq_shift_params_t init_params = {
-			//.algo_freq_shift_params.read_size = s_algo_read_size,
-			//.algo_freq_shift_params.shift_amount = shift_amount
-		//};
-		//algo_freq_init(&init_params);
-		break;
-	case FAD_ALGO_MASKING:
-		ESP_LOGI(FAD_TAG, "Changing algo to Masking");
-		s_algo_func = algo_masking;
-		s_algo_deinit_func = algo_delay_deinit;
-		s_algo_read_size = 2048;
-		algo_masking_init();
-		break;
-	case FAD_ALGO_DELAY:
-		ESP_LOGI(FAD_TAG, "Changing algo to Delay");
-		s_algo_func = algo_delay;
-		s_algo_deinit_func = algo_delay_deinit;
-		s_algo_read_size = 512;
-		algo_delay_init();
-	default:
-		ESP_LOGI(FAD_TAG, "Unhandled algo function %d", type);
-		break;
+	fad_chain_t *next = fad_swap_stage(&s_algo_swap);
+
+	ESP_LOGI(FAD_TAG, "Changing algo to %s, Mode %d", desc->name, mode);
+	esp_err_t err = fad_chain_add(next, type, mode);
+	if (err)
+	{
+		parse_error(err);
+		fad_swap_abort(&s_algo_swap);
+		return;
 	}
+	fad_swap_commit(&s_algo_swap);
 }
 
 /*Main function to determine the tasks*/
@@ -241,7 +233,7 @@ void fad_main_stack_evt_handler(uint16_t evt, void *params)
 		err = adc_timer_init();
 		err = adc_init();
 		err = dac_init();
-		err = adc_timer_set_read_size(s_algo_read_size);
+		err = adc_timer_set_read_size(FAD_BLOCK_SIZE);
 		
 		parse_error(err);
 		adc_timer_start();
@@ -331,7 +323,7 @@ void fad_main_stack_evt_handler(uint16_t evt, void *params)
 		err = adc_timer_init();
 		err = adc_init();
 		err = dac_init();
-		err = adc_timer_set_read_size(s_algo_read_size);
+		err = adc_timer_set_read_size(FAD_BLOCK_SIZE);
 		parse_error(err);
 		adc_timer_start();
 		break;
@@ -350,9 +342,28 @@ void fad_main_stack_evt_handler(uint16_t evt, void *params)
 		handle_algo_change(p->change_algo.algo_type, p->change_algo.algo_mode);
 		break;
 
+	case FAD_ALGO_RETIRED: // The previous algorithm finished fading out. Free its state.
+		fad_swap_release(&s_algo_swap);
+		break;
+
 	case FAD_ADC_BUFFER_READY:;
 		struct adc_buffer_rdy_param buff = p->adc_buff_pos_info;
-		s_algo_func(adc_buffer, dac_buffer, buff.adc_pos, buff.dac_pos, MULTISAMPLES);  //Send input values to algorithms
+		{
+			/* Describe this block of the circular buffers. The chain gets one Q15 input per output, so multisampled values are averaged while converting */
+			fad_adc_span_t adc_span;
+			fad_span_t in_span;
+			fad_dac_span_t out_span;
+			fad_adc_span_init(&adc_span, adc_buffer, ADC_BUFFER_SIZE, buff.adc_pos, FAD_BLOCK_SIZE);
+			fad_span_from_adc(&adc_span, s_algo_input, MULTISAMPLES);
+			fad_dc_block(&s_input_dc, s_algo_input, FAD_BLOCK_SIZE / MULTISAMPLES);
+			fad_span_init(&in_span, s_algo_input, FAD_BLOCK_SIZE / MULTISAMPLES, 0, FAD_BLOCK_SIZE / MULTISAMPLES);
+			fad_dac_span_init(&out_span, dac_buffer, DAC_BUFFER_SIZE, buff.dac_pos, FAD_BLOCK_SIZE / MULTISAMPLES);
+			if (fad_swap_process(&s_algo_swap, &in_span, &out_span))  //Send input values to algorithms
+			{
+				/* Old algorithm has faded out. Free it after this block rather than inside it */
+				fad_app_work_dispatch(fad_main_stack_evt_handler, FAD_ALGO_RETIRED, NULL, 0, NULL);
+			}
+		}
 		//ESP_LOGI(FAD_TAG, "Dac buffer: %d", dac_buffer[100]);
 		//if(++s_adc_calls % 128 == 0);
 		 	//ESP_LOGI(FAD_TAG, "ADC Calls: %d", s_adc_calls);